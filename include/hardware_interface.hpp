@@ -1,15 +1,13 @@
 #ifndef __HARDWARE_INTERFACE_HPP__
 #define __HARDWARE_INTERFACE_HPP__
 
+#include <stddef.h>
 #include <stdint.h>
 
-// Arduino環境ではArduinoのStringを使用、それ以外ではstd::string
-#if defined(ARDUINO)
-    #include <WString.h>
-#else
-    #include <string>
-    using String = std::string;
-#endif
+// 文字列の最大サイズ（終端を含む）。文字列は呼び出し側のバッファでやり取りし、ヒープを使わない
+static const size_t WIFI_SSID_SIZE     = 33;  // SSID 32バイト + 終端
+static const size_t WIFI_PASSWORD_SIZE = 65;  // WPA2パスフレーズ 63文字（16進なら64文字）+ 終端
+static const size_t IP_ADDRESS_SIZE    = 16;  // "255.255.255.255" + 終端
 
 /**
  * @brief WiFi接続状態
@@ -26,14 +24,28 @@ enum class WiFiStatus {
  * @brief WiFiネットワーク情報
  */
 struct WiFiNetwork {
-    String ssid;        // SSID
-    int8_t rssi;        // 信号強度 (dBm)
-    bool isEncrypted;   // 暗号化の有無
+    char ssid[WIFI_SSID_SIZE];  // SSID
+    int8_t rssi;                // 信号強度 (dBm)
+    bool isEncrypted;           // 暗号化の有無
+};
+
+/**
+ * @brief ボタンイベント（デバウンス済みのエッジ）
+ */
+struct ButtonEvent {
+    static const uint8_t A = 0;
+    static const uint8_t B = 1;
+
+    uint32_t time_ms;   // エッジの時刻（実機は割り込み時に取得）
+    uint8_t button;     // ButtonEvent::A / ButtonEvent::B
+    bool pressed;       // true=押下, false=解放
 };
 
 /**
  * @brief ハードウェア機能の抽象化インターフェース
  * エミュレーター環境と実機環境の両方で使用可能
+ * アプリはビルドごとに選ばれた具象型（hardware.hpp の Hardware）を直接呼ぶ。
+ * このインターフェースは実装を差し替えたい場合（テストなど）のために HardwareAdapter 経由で残す。
  */
 class HardwareInterface {
 public:
@@ -48,6 +60,7 @@ public:
     virtual bool isButtonBPressed() = 0;
     virtual bool wasButtonAPressed() = 0;
     virtual bool wasButtonBPressed() = 0;
+    virtual bool popButtonEvent(ButtonEvent* event) = 0;  // 押下/解放イベントを古い順に取り出す
     
     // IMU (加速度センサー)
     virtual void getAccel(float* x, float* y, float* z) = 0;
@@ -62,26 +75,167 @@ public:
     virtual float getWeightGrams() = 0;
     virtual bool tareWeightSensor() = 0;
     virtual bool calibrateWeightSensor(float knownWeightGrams) = 0;
+    virtual float getWeightScale() = 0;             // 換算係数（校正結果の保存用）
+    virtual void setWeightScale(float scale) = 0;   // 換算係数の設定（保存した校正結果の復元）
     
     // LCD輝度
     virtual void setBrightness(uint8_t brightness) = 0;  // 0-255
     virtual uint8_t getBrightness() = 0;
     
+    // 設定の保存先（ConfigStore が使う、内容は解釈しない）
+    virtual size_t loadConfig(void* data, size_t size) = 0;             // 読み込んだバイト数（なければ0）
+    virtual bool saveConfig(const void* data, size_t size) = 0;         // 設定の保存
+
     // WiFi機能
-    virtual bool hasWiFiConfig() = 0;                                    // WiFi設定の有無
-    virtual bool loadWiFiConfig(String& ssid, String& password) = 0;    // WiFi設定の読み込み
-    virtual void saveWiFiConfig(const String& ssid, const String& password) = 0;  // WiFi設定の保存
-    virtual void clearWiFiConfig() = 0;                                 // WiFi設定のクリア
+    virtual bool loadWiFiConfig(char* ssid, size_t ssid_size,
+                                char* password, size_t password_size) = 0;  // 旧形式のWiFi設定の読み込み（移行用）
     virtual WiFiStatus getWiFiStatus() = 0;                             // WiFi接続状態の取得
-    virtual bool connectWiFi(const String& ssid, const String& password) = 0;  // WiFi接続
+    virtual bool connectWiFi(const char* ssid, const char* password) = 0;  // WiFi接続
     virtual void disconnectWiFi() = 0;                                  // WiFi切断
     virtual int scanNetworks(WiFiNetwork* networks, int maxNetworks) = 0;  // ネットワークスキャン
-    virtual bool startAPMode(const String& ssid) = 0;                   // APモード開始
+    virtual bool startAPMode(const char* ssid) = 0;                     // APモード開始
     virtual void stopAPMode() = 0;                                      // APモード停止
-    virtual String getIPAddress() = 0;                                  // IPアドレス取得
+    virtual void getIPAddress(char* buf, size_t size) = 0;              // IPアドレス取得（IP_ADDRESS_SIZE 以上）
+};
+
+/**
+ * @brief 具象型のハードウェア実装を HardwareInterface として扱うアダプター
+ */
+template <typename T>
+class HardwareAdapter : public HardwareInterface {
+public:
+    explicit HardwareAdapter(T& impl) : impl(impl)
+    {
+    }
+
+    void begin() override
+    {
+        impl.begin();
+    }
+    void update() override
+    {
+        impl.update();
+    }
+
+    bool isButtonAPressed() override
+    {
+        return impl.isButtonAPressed();
+    }
+    bool isButtonBPressed() override
+    {
+        return impl.isButtonBPressed();
+    }
+    bool wasButtonAPressed() override
+    {
+        return impl.wasButtonAPressed();
+    }
+    bool wasButtonBPressed() override
+    {
+        return impl.wasButtonBPressed();
+    }
+    bool popButtonEvent(ButtonEvent* event) override
+    {
+        return impl.popButtonEvent(event);
+    }
+
+    void getAccel(float* x, float* y, float* z) override
+    {
+        impl.getAccel(x, y, z);
+    }
+    void getGyro(float* x, float* y, float* z) override
+    {
+        impl.getGyro(x, y, z);
+    }
+
+    float getBatteryVoltage() override
+    {
+        return impl.getBatteryVoltage();
+    }
+    int getBatteryLevel() override
+    {
+        return impl.getBatteryLevel();
+    }
+
+    bool hasWeightSensor() override
+    {
+        return impl.hasWeightSensor();
+    }
+    float getWeightGrams() override
+    {
+        return impl.getWeightGrams();
+    }
+    bool tareWeightSensor() override
+    {
+        return impl.tareWeightSensor();
+    }
+    bool calibrateWeightSensor(float knownWeightGrams) override
+    {
+        return impl.calibrateWeightSensor(knownWeightGrams);
+    }
+    float getWeightScale() override
+    {
+        return impl.getWeightScale();
+    }
+    void setWeightScale(float scale) override
+    {
+        impl.setWeightScale(scale);
+    }
+
+    void setBrightness(uint8_t brightness) override
+    {
+        impl.setBrightness(brightness);
+    }
+    uint8_t getBrightness() override
+    {
+        return impl.getBrightness();
+    }
+
+    size_t loadConfig(void* data, size_t size) override
+    {
+        return impl.loadConfig(data, size);
+    }
+    bool saveConfig(const void* data, size_t size) override
+    {
+        return impl.saveConfig(data, size);
+    }
+    bool loadWiFiConfig(char* ssid, size_t ssid_size, char* password, size_t password_size) override
+    {
+        return impl.loadWiFiConfig(ssid, ssid_size, password, password_size);
+    }
+    WiFiStatus getWiFiStatus() override
+    {
+        return impl.getWiFiStatus();
+    }
+    bool connectWiFi(const char* ssid, const char* password) override
+    {
+        return impl.connectWiFi(ssid, password);
+    }
+    void disconnectWiFi() override
+    {
+        impl.disconnectWiFi();
+    }
+    int scanNetworks(WiFiNetwork* networks, int maxNetworks) override
+    {
+        return impl.scanNetworks(networks, maxNetworks);
+    }
+    bool startAPMode(const char* ssid) override
+    {
+        return impl.startAPMode(ssid);
+    }
+    void stopAPMode() override
+    {
+        impl.stopAPMode();
+    }
+    void getIPAddress(char* buf, size_t size) override
+    {
+        impl.getIPAddress(buf, size);
+    }
+
+private:
+    T& impl;
 };
 
-// グローバルインスタンスの取得
+// ビルドの実装を HardwareInterface として取得（テストなど差し替え用、通常は hardware() を使う）
 HardwareInterface* getHardware();
 
 #endif  // __HARDWARE_INTERFACE_HPP__
@@ -0,0 +1,97 @@
+#ifndef __BENCH_HPP__
+#define __BENCH_HPP__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+
+/**
+ * @brief ネイティブベンチマークの簡易ハーネス
+ * 1回あたり約 BENCH_TARGET_NS になるよう反復回数を自動調整し、
+ * BENCH_REPEAT 回計測した最小値・中央値を JSON Lines で出力する。
+ */
+
+#ifndef BENCH_TARGET_NS
+#define BENCH_TARGET_NS 20000000ULL  // 20ms
+#endif
+#ifndef BENCH_REPEAT
+#define BENCH_REPEAT 5
+#endif
+
+/**
+ * @brief 計算結果を最適化で消されないようにする
+ */
+template <typename T>
+inline void bench_keep(const T& value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+class BenchSuite {
+public:
+    explicit BenchSuite(FILE* out) : out(out), filter(nullptr)
+    {
+    }
+
+    /**
+     * @brief 名前に部分一致するベンチマークのみ実行する
+     */
+    void setFilter(const char* pattern)
+    {
+        filter = pattern;
+    }
+
+    /**
+     * @brief ベンチマークを実行して1行出力
+     * @param name ベンチマーク名（"<分類>.<項目>"）
+     * @param fn 1回の操作（fn(i) の i は通し番号）
+     */
+    template <typename Fn>
+    void run(const char* name, Fn&& fn)
+    {
+        if (filter && nullptr == strstr(name, filter)) {
+            return;
+        }
+
+        // 反復回数の調整（目標時間を超えるまで倍増）
+        uint64_t iterations = 1;
+        uint64_t serial     = 0;
+        while (true) {
+            uint64_t ns = measure(fn, iterations, serial);
+            if (BENCH_TARGET_NS <= ns || (1ULL << 30) <= iterations) {
+                break;
+            }
+            iterations *= 2;
+        }
+
+        double samples[BENCH_REPEAT];
+        for (int r = 0; r < BENCH_REPEAT; r++) {
+            samples[r] = (double)measure(fn, iterations, serial) / (double)iterations;
+        }
+        std::sort(samples, samples + BENCH_REPEAT);
+
+        fprintf(out, "{\"name\":\"%s\",\"iterations\":%llu,\"ns_per_op\":%.2f,\"ns_per_op_median\":%.2f}\n", name,
+                (unsigned long long)iterations, samples[0], samples[BENCH_REPEAT / 2]);
+        fflush(out);
+    }
+
+private:
+    FILE* out;
+    const char* filter;
+
+    template <typename Fn>
+    static uint64_t measure(Fn& fn, uint64_t iterations, uint64_t& serial)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < iterations; i++) {
+            fn(serial++);
+        }
+        auto end = std::chrono::steady_clock::now();
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    }
+};
+
+#endif  // __BENCH_HPP__
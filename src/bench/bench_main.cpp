@@ -0,0 +1,326 @@
+#if defined(APP_BENCHMARK)
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app_log.hpp"
+#include "bench.hpp"
+#include "bound_label.hpp"
+#include "hardware.hpp"
+#include "lvgl_port_m5stack.hpp"
+#include "lvgl_tile_cache.hpp"
+#include "qrcode_generator.hpp"
+#include "sensor_snapshot.hpp"
+#include "sensor_trace.hpp"
+#include "weight_history.hpp"
+
+extern void create_screen_main(void);
+extern void update_screen_main_weight(float weight, bool valid);
+
+// ネイティブベンチマーク
+// 重量処理・UI更新・QRコード・ログエンコーダーの ns/op を JSON Lines で出力する。
+//   program [--filter <部分一致>] [--out <ファイル>]
+// 動作の検証はユニットテスト（test/test_*/、pio test -e native）で行う。
+// 2つのコミットの結果は support/bench_compare.py で比較できる。
+
+///////////////////////////////////////
+/// @brief 重量処理（校正換算・履歴・表示用整形）
+static void bench_weight(BenchSuite& suite)
+{
+    static int32_t raw[1024];
+    for (int i = 0; i < 1024; i++) {
+        raw[i] = 8000 + (int32_t)(i * 97 % 60000);
+    }
+    SensorTraceCalibration calib = {8000, 27.61f};
+
+    suite.run("weight.calibration_to_grams", [&](uint64_t i) {
+        float grams = sensor_trace_to_grams(calib, raw[i & 1023]);
+        bench_keep(grams);
+    });
+
+    static WeightHistory history;
+    suite.run("weight.history_add", [&](uint64_t i) {
+        history.add((float)(raw[i & 1023] - 8000), (uint32_t)(i * 100));
+    });
+
+    suite.run("weight.history_summarize_1h", [&](uint64_t) {
+        WeightBucket hour;
+        history.summarize(WeightHistory::TIER_1MIN, WeightHistory::CAPACITY_1MIN, &hour);
+        bench_keep(hour);
+    });
+
+    suite.run("weight.format_kg", [&](uint64_t i) {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%.2f", (raw[i & 1023] - 8000) / 1000.0f);
+        bench_keep(buf);
+    });
+}
+
+///////////////////////////////////////
+/// @brief メイン画面の重量ラベル更新と描画
+static void bench_ui(BenchSuite& suite)
+{
+    lv_obj_clean(lv_scr_act());
+    create_screen_main();
+    lv_refr_now(NULL);
+
+    // 毎回異なる値（ラベル再設定・再配置・無効化のコスト）
+    suite.run("ui.main_weight_update", [&](uint64_t i) {
+        update_screen_main_weight((float)(i % 6000), true);
+    });
+
+    // 同じ値の再設定（変化がなくても発生するコスト）
+    suite.run("ui.main_weight_update_same", [&](uint64_t) {
+        update_screen_main_weight(1234.0f, true);
+    });
+
+    // 更新＋描画（ヘッドレスのため転送は含まない）
+    suite.run("ui.main_weight_update_render", [&](uint64_t i) {
+        update_screen_main_weight((float)(i % 6000), true);
+        lv_refr_now(NULL);
+    });
+
+    // 同じテキストの再設定＋描画：直接設定（毎回無効化）とバインディング（比較のみ）
+    lv_obj_t* label = lv_label_create(lv_scr_act());
+    suite.run("ui.label_set_same_render", [&](uint64_t) {
+        lv_label_set_text(label, "Weight: 1234.5 g");
+        lv_refr_now(NULL);
+    });
+
+    static BoundText<> bound;
+    bound.bind(label);
+    suite.run("ui.bound_label_set_same_render", [&](uint64_t) {
+        bound.set("Weight: 1234.5 g");
+        lv_refr_now(NULL);
+    });
+}
+
+///////////////////////////////////////
+/// @brief フラッシュ差分（タイルハッシュ）のコスト
+static void bench_display(BenchSuite& suite)
+{
+    static TileCache cache;
+    static uint16_t band[240 * TileCache::TILE];
+    cache.begin(240, 135);
+    for (int i = 0; i < 240 * TileCache::TILE; i++) {
+        band[i] = (uint16_t)(i * 31);
+    }
+
+    // 内容が変わらない帯（ハッシュ計算のみ、転送なし）
+    suite.run("display.tile_diff_unchanged_band", [&](uint64_t) {
+        cache.flush(band, 0, 16, 239, 16 + TileCache::TILE - 1, [](int, int, int, int, const uint16_t*, int) {});
+    });
+
+    // 毎回1タイルだけ変わる帯
+    suite.run("display.tile_diff_one_tile_changed", [&](uint64_t i) {
+        band[(i % 15) * TileCache::TILE] ^= 0xFFFF;
+        cache.flush(band, 0, 16, 239, 16 + TileCache::TILE - 1, [](int, int, int, int, const uint16_t* first, int) {
+            bench_keep(first);
+        });
+    });
+}
+
+///////////////////////////////////////
+/// @brief QRコード生成とキャンバス描画
+static void bench_qrcode(BenchSuite& suite)
+{
+    static QRCodeGenerator::Matrix qr;
+
+    // WiFi参加用ペイロード（長め、バージョン自動選択）
+    suite.run("qr.generate_wifi_join", [&](uint64_t) {
+        QRCodeGenerator::generate("WIFI:T:WPA;S:M5Stack-Scale-Setup-0123;P:correct-horse-battery-staple;;", qr);
+        bench_keep(qr);
+    });
+
+    suite.run("qr.generate", [&](uint64_t) {
+        QRCodeGenerator::generate("http://192.168.4.1/", qr);
+        bench_keep(qr);
+    });
+
+    const int scale       = 2;
+    const int margin      = 4;
+    const int canvas_size = qr.size * scale + margin * 2;
+    alignas(LV_DRAW_BUF_ALIGN) static uint8_t cbuf[LV_CANVAS_BUF_SIZE(80, 80, 16, LV_DRAW_BUF_STRIDE_ALIGN)];
+
+    lv_obj_clean(lv_scr_act());
+    lv_obj_t* canvas = lv_canvas_create(lv_scr_act());
+
+    // 変更前の方式（1ピクセルずつ lv_canvas_set_px）を比較基準として残す
+    lv_canvas_set_buffer(canvas, cbuf, canvas_size, canvas_size, LV_COLOR_FORMAT_RGB565);
+    suite.run("qr.draw_canvas_set_px_reference", [&](uint64_t) {
+        lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+        for (uint8_t y = 0; y < qr.size; y++) {
+            for (uint8_t x = 0; x < qr.size; x++) {
+                lv_color_t color = qr.get(x, y) ? lv_color_black() : lv_color_white();
+                for (int sy = 0; sy < scale; sy++) {
+                    for (int sx = 0; sx < scale; sx++) {
+                        lv_canvas_set_px(canvas, margin + x * scale + sx, margin + y * scale + sy, color,
+                                         LV_OPA_COVER);
+                    }
+                }
+            }
+        }
+    });
+
+    suite.run("qr.draw_canvas", [&](uint64_t) {
+        QRCodeGenerator::drawToCanvas(canvas, qr, scale, margin);
+    });
+
+    lv_canvas_set_buffer(canvas, cbuf, canvas_size, canvas_size, LV_COLOR_FORMAT_A8);
+    suite.run("qr.draw_canvas_a8", [&](uint64_t) {
+        QRCodeGenerator::drawToCanvas(canvas, qr, scale, margin);
+    });
+
+    lv_canvas_set_buffer(canvas, cbuf, canvas_size, canvas_size, LV_COLOR_FORMAT_I1);
+    suite.run("qr.draw_canvas_i1", [&](uint64_t) {
+        QRCodeGenerator::drawToCanvas(canvas, qr, scale, margin);
+    });
+
+    lv_obj_clean(lv_scr_act());
+}
+
+///////////////////////////////////////
+/// @brief ログエンコーダー（センサートレース）
+static void bench_encoders(BenchSuite& suite)
+{
+    SensorTraceSample sample = {123456, -56789, {0.01f, -0.02f, 0.98f}, {1.5f, -2.25f, 0.0f}, 0};
+    char line[SENSOR_TRACE_LINE_MAX];
+
+    suite.run("log.trace_encode", [&](uint64_t i) {
+        sample.time_ms = (uint32_t)i;
+        int len        = sensor_trace_format_sample(line, sizeof(line), sample);
+        bench_keep(len);
+    });
+
+    sensor_trace_format_sample(line, sizeof(line), sample);
+    suite.run("log.trace_decode", [&](uint64_t) {
+        SensorTraceSample decoded;
+        char kind = sensor_trace_parse_line(line, &decoded, nullptr);
+        bench_keep(kind);
+        bench_keep(decoded);
+    });
+}
+
+///////////////////////////////////////
+/// @brief センサー最新値の公開と読み出し
+static void bench_snapshot(BenchSuite& suite)
+{
+    SensorSnapshot snapshot = {};
+
+    suite.run("snapshot.publish", [&](uint64_t i) {
+        snapshot.weight_serial = (uint32_t)i;
+        sensor_snapshot_publish(snapshot);
+    });
+
+    suite.run("snapshot.read", [&](uint64_t) {
+        SensorSnapshot copy;
+        uint32_t serial = sensor_snapshot_read(&copy);
+        bench_keep(serial);
+        bench_keep(copy);
+    });
+}
+
+///////////////////////////////////////
+/// @brief ログ（遅延ログに積む・取り出す、比較用に呼び出し側で整形する場合）
+static void bench_log(BenchSuite& suite)
+{
+    AppLogRecord record;
+
+    suite.run("log.deferred", [&](uint64_t i) {
+        app_log_write(APP_LOG_LEVEL_INFO, "Screen: %s -> %s (%s, %lu us)", "main", "trend", "A short",
+                      (unsigned long)i);
+        bool popped = app_log_pop(&record);
+        bench_keep(popped);
+    });
+
+    suite.run("log.snprintf", [&](uint64_t i) {
+        char line[128];
+        int len = snprintf(line, sizeof(line), "Screen: %s -> %s (%s, %lu us)\n", "main", "trend", "A short",
+                           (unsigned long)i);
+        bench_keep(len);
+        bench_keep(line);
+    });
+
+    suite.run("log.format", [&](uint64_t) {
+        char line[128];
+        size_t len = app_log_format(record, line, sizeof(line));
+        bench_keep(len);
+        bench_keep(line);
+    });
+}
+
+///////////////////////////////////////
+/// @brief ハードウェア呼び出し（HardwareInterface の仮想呼び出しと Hardware の直接呼び出し）
+static void bench_hal(BenchSuite& suite)
+{
+    HardwareInterface* adapter = getHardware();
+    Hardware& direct           = hardware();
+
+    suite.run("hal.buttons_virtual", [&](uint64_t) {
+        bool pressed = adapter->isButtonAPressed() | adapter->isButtonBPressed() | adapter->wasButtonAPressed();
+        bench_keep(pressed);
+    });
+
+    suite.run("hal.buttons_direct", [&](uint64_t) {
+        bool pressed = direct.isButtonAPressed() | direct.isButtonBPressed() | direct.wasButtonAPressed();
+        bench_keep(pressed);
+    });
+
+    suite.run("hal.weight_virtual", [&](uint64_t) {
+        float grams = adapter->hasWeightSensor() ? adapter->getWeightGrams() : 0.0f;
+        bench_keep(grams);
+    });
+
+    suite.run("hal.weight_direct", [&](uint64_t) {
+        float grams = direct.hasWeightSensor() ? direct.getWeightGrams() : 0.0f;
+        bench_keep(grams);
+    });
+}
+
+int main(int argc, char** argv)
+{
+    const char* filter   = nullptr;
+    const char* out_path = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (0 == strcmp(argv[i], "--filter") && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (0 == strcmp(argv[i], "--out") && i + 1 < argc) {
+            out_path = argv[++i];
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    FILE* out = stdout;
+    if (out_path) {
+        out = fopen(out_path, "w");
+        if (nullptr == out) {
+            fprintf(stderr, "Cannot open %s\n", out_path);
+            return 1;
+        }
+    }
+
+    hardware_begin();
+    lvgl_port_init();
+
+    BenchSuite suite(out);
+    suite.setFilter(filter);
+
+    bench_weight(suite);
+    bench_ui(suite);
+    bench_display(suite);
+    bench_qrcode(suite);
+    bench_encoders(suite);
+    bench_snapshot(suite);
+    bench_hal(suite);
+    bench_log(suite);
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    return 0;
+}
+
+#endif
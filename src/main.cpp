@@ -2,13 +2,17 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include "lvgl_port_m5stack.hpp"
-#include "hardware_interface.hpp"
+#include "hardware.hpp"
+#include "app_clock.hpp"
+#include "heap_audit.hpp"
 
 extern void user_app_setup(void);
-extern void user_app_loop(void);
+extern uint32_t user_app_loop(void);
 extern void update_screen_main(void);
 
+#if !defined(EMULATOR_HEADLESS)
 M5GFX gfx;
+#endif
 
 void setup(void)
 {
@@ -22,6 +26,12 @@ void setup(void)
     Serial.flush();
 #endif
 
+#if defined(EMULATOR_HEADLESS)
+    // ヘッドレス：表示デバイスなし
+    printf("Headless emulator (virtual clock)\n");
+    hardware_begin();
+    lvgl_port_init();
+#else
     // M5GFXの初期化
     gfx.init();
     // 回転指定: 0=0°, 2=180°, 
@@ -40,9 +50,9 @@ void setup(void)
     Serial.println("[1] M5GFX initialized");
     
     // ハードウェアの初期化
-    // getHardware() 内で begin() が1回だけ実行される
+    // hardware_begin() は begin() を1回だけ実行する
     Serial.println("[2] Initializing hardware...");
-    (void)getHardware();
+    hardware_begin();
     Serial.flush();
 #else
     printf("M5GFX initialized: %dx%d\n", gfx.width(), gfx.height());
@@ -54,6 +64,7 @@ void setup(void)
     Serial.flush();
 #endif
     lvgl_port_init(gfx);
+#endif
 
     // ユーザーアプリケーション初期化
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
@@ -67,16 +78,16 @@ void setup(void)
     Serial.println("========================================");
     Serial.flush();
 #endif
+
+    // ここからのヒープ確保は定常状態として数える（APP_STATIC_MEMORY）
+    heap_audit_mark_steady();
 }
 
 void loop(void)
 {
-    // ハードウェアデモの更新
-    user_app_loop();
+    // 期限を過ぎた周期ジョブを実行
+    uint32_t wait_ms = user_app_loop();
 
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-    delay(10);
-#elif !defined(ARDUINO) && (__has_include(<SDL2/SDL.h>) || __has_include(<SDL.h>))
-    usleep(10 * 1000);
-#endif
+    // 次の期限まで待機（ヘッドレスでは仮想時計を進めるだけ）
+    app_clock_sleep_ms(wait_ms);
 }
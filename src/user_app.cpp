@@ -1,10 +1,25 @@
 #include "lvgl.h"
 #include "lvgl_port_m5stack.hpp"
-#include "hardware_interface.hpp"
+#include "app_clock.hpp"
+#include "app_log.hpp"
+#include "app_scheduler.hpp"
+#include "app_tasks.hpp"
+#include "config_store.hpp"
+#include "sensor_snapshot.hpp"
+#include "hardware.hpp"
+#include "heap_audit.hpp"
+#include "static_slot.hpp"
 #include "qrcode_generator.hpp"
 #include "wifi_webserver.hpp"
+#include "bound_label.hpp"
+#include "button_gestures.hpp"
+#include "weight_digits.hpp"
+#include "weight_history.hpp"
+#include <math.h>
 #include <stdio.h>
 #include <string.h>
+#include <atomic>
+#include <mutex>
 
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
 #include <ESP.h>
@@ -16,27 +31,149 @@ enum AppScreen {
     SCREEN_START,       // スタート画面
     SCREEN_MAIN,        // メイン画面
     SCREEN_VERSION,     // バージョン表示画面
-    SCREEN_CALIBRATION  // 重量センサー校正画面
+    SCREEN_CALIBRATION, // 重量センサー校正画面
+    SCREEN_TREND,       // 重量トレンド（直近1時間）画面
+    SCREEN_COUNT        // 画面数（未表示）
 };
 
-static AppScreen current_screen = SCREEN_START;
+static AppScreen current_screen = SCREEN_COUNT;  // アプリタスクからのみ使う
+
+// 重量サンプリングの対象（画面ごと、計測タスクは current_screen ではなくこちらを読む）
+enum WeightSampling : uint8_t {
+    SAMPLING_OFF,      // 読み出さない
+    SAMPLING_LIVE,     // 最新値の公開のみ（校正中の値は履歴に残さない）
+    SAMPLING_HISTORY   // 最新値の公開と履歴への追加
+};
+static std::atomic<uint8_t> weight_sampling(SAMPLING_OFF);
+
+static void screen_transition(AppScreen next, const char* reason);
 
 // WiFi設定画面用の変数
-static lv_obj_t* label_wifi_status = nullptr;
+static BoundText<> label_wifi_status;
 static lv_obj_t* label_wifi_ssid = nullptr;
 static lv_obj_t* label_wifi_ip = nullptr;
 static lv_obj_t* qrcode_canvas = nullptr;
-static WiFiWebServer* webServer = nullptr;
-static uint8_t qrcode_data[QRCodeGenerator::MAX_SIZE][QRCodeGenerator::MAX_SIZE];
-static uint8_t qrcode_size = 2;
+static StaticSlot<WiFiWebServer> web_server_slot;  // Webサーバーの静的領域（ヒープを使わない）
+static std::atomic<WiFiWebServer*> webServer(nullptr);  // 画面が開始して公開し、以降はネットワークタスクだけが触る
+static std::mutex net_mutex;  // wifi_received（ネットワークタスクと画面）
+
+// Webサーバーで受け取ったWiFi設定（ネットワークタスクから画面へ渡す）
+static struct {
+    bool received;
+    char ssid[WIFI_SSID_SIZE];
+    char password[WIFI_PASSWORD_SIZE];
+} wifi_received;
+static QRCodeGenerator::Matrix qrcode_data;
 
 // ハードウェアインタラクティブなデモアプリ
-static lv_obj_t* label_status = nullptr;
+static BoundText<> label_status;
 static lv_obj_t* label_weight_prefix = nullptr;
-static lv_obj_t* label_weight_value = nullptr;
+static WeightDigits weight_digits;           // 重量値（7セグメント表示）
 static lv_obj_t* label_weight_unit = nullptr;
-static lv_obj_t* label_calib_status = nullptr;
-static lv_obj_t* label_calib_weight = nullptr;
+static int32_t weight_digits_room = 0;       // "weight:" に重ならずに数字を置ける幅 [px]
+static BoundText<> label_calib_status;
+
+// 重量履歴（1秒/1分/15分のダウンサンプリング）
+static WeightHistory weight_history;
+static std::mutex weight_mutex;              // 重量の履歴（計測タスクとトレンド画面）
+static SensorSnapshot sensor_draft;          // 計測タスクが更新して公開する最新値（sensor_snapshot_read() で読む）
+static std::mutex scale_mutex;               // 重量センサーへのアクセス（計測タスク）
+
+// 校正画面から計測タスクへの tare・校正の依頼（HX711の読み出しで約1秒かかるため、LVGLロック内では待たない）
+// 校正画面が依頼を書き、計測タスクが実行して結果を書き、校正画面が結果を表示して SCALE_JOB_NONE に戻す
+enum ScaleJob : uint8_t {
+    SCALE_JOB_NONE,
+    SCALE_JOB_TARE,       // 依頼：tare
+    SCALE_JOB_CALIBRATE,  // 依頼：2000g で校正
+    SCALE_JOB_DONE,       // 結果：成功
+    SCALE_JOB_FAILED      // 結果：失敗
+};
+static std::atomic<uint8_t> scale_job(SCALE_JOB_NONE);
+static uint8_t scale_job_requested = SCALE_JOB_NONE;  // 表示中の依頼（校正画面）
+static float scale_job_scale       = 0.0f;            // 校正後の換算係数（SCALE_JOB_DONE の前に書く）
+
+static const float CALIBRATION_GRAMS = 2000.0f;  // 校正に使う既知の重量 [g]
+
+// トレンド画面用の変数
+static lv_obj_t* trend_chart = nullptr;
+static lv_chart_series_t* trend_series_mean = nullptr;
+static lv_chart_series_t* trend_series_min = nullptr;
+static lv_chart_series_t* trend_series_max = nullptr;
+static uint32_t trend_shown_serial = 0;      // チャートに反映済みの1分バケット通し番号
+static int32_t trend_range_max = 0;          // チャートのY軸上限 [g]
+
+// 校正画面の重量表示（NAN = センサーなし）
+struct CalibWeightFormat {
+    void operator()(char* buf, size_t size, float grams) const
+    {
+        if (isnan(grams)) {
+            snprintf(buf, size, "Weight: sensor N/A");
+        } else {
+            snprintf(buf, size, "Weight: %.1f g", grams);
+        }
+    }
+};
+static BoundLabel<float, CalibWeightFormat> label_calib_weight;
+
+// トレンド画面の直近1時間の集計（count = 0 は収集中）
+struct TrendSummaryFormat {
+    void operator()(char* buf, size_t size, const WeightBucket& hour) const
+    {
+        if (0 == hour.count) {
+            snprintf(buf, size, "collecting...");
+        } else {
+            snprintf(buf, size, "min %.2f  avg %.2f  max %.2f",
+                     hour.min / 1000.0f, hour.mean / 1000.0f, hour.max / 1000.0f);
+        }
+    }
+};
+static BoundLabel<WeightBucket, TrendSummaryFormat, 64> label_trend_value;
+
+// ボタン操作の認識（全画面共通、画面遷移時にリセット）
+static ButtonGestures button_gestures;
+static const uint32_t BUTTON_A_LONG_MS = 1500;  // A長押し（メイン→バージョン、校正→メイン）
+static const uint32_t BUTTON_B_LONG_MS = 3000;  // B長押し（WiFi設定リセット）
+
+// ボタンのLVGL入力デバイス（A=ENTER, B=NEXT のキーパッド）
+// イベント駆動（LV_INDEV_MODE_EVENT）で、ボタンのエッジごとに job_buttons() から読ませる。
+// 周期の読み出しタイマーを持たないため、画面に変化がなければLVGLタスクは更新周期の調整どおり眠る
+static lv_indev_t* button_indev = nullptr;
+static ButtonEvent button_indev_event = {0, ButtonEvent::A, false};  // 読ませるエッジ（LVGLロック内）
+
+// 周期ジョブ（タスクごとのスケジューラー、各タスクは次の期限まで待つ）
+struct SchedulerTask {
+    AppTaskId id;
+    AppScheduler scheduler;
+    bool threaded;  // false: タスクを作れない環境（ヘッドレス）では user_app_loop() から実行
+};
+static AppScheduler scheduler;  // アプリ（Arduinoの loop()）
+static SchedulerTask sensor_task       = {APP_TASK_SENSOR, {}, false};
+static SchedulerTask net_task          = {APP_TASK_NET, {}, false};
+static bool log_threaded               = false;  // false: ログは user_app_loop() から出力
+static int job_screen                  = -1;    // 画面の周期処理（周期は画面ごと）
+static const uint32_t JOB_BUTTONS_MS   = 5;     // ボタン走査・操作の振り分け（200Hz）
+static const uint32_t JOB_WEIGHT_MS    = 100;   // 重量サンプリング（10Hz、計測タスク）
+static const uint32_t JOB_STATUS_MS    = 1000;  // IMU・バッテリー・WiFi状態の取得（1Hz、計測タスク）
+static const uint32_t JOB_WEB_MS       = 10;    // Webサーバーのリクエスト処理（ネットワークタスク）
+static const uint32_t JOB_BLINK_MS     = 1000;  // WiFi設定画面の点滅（1Hz）
+static const uint32_t JOB_CONFIG_MS    = 500;   // 設定の書き込み（変更をまとめてから）
+static const uint32_t LOOP_MAX_WAIT_MS = 1000;  // 待機の上限 [ms]
+
+// タスクごとのCPU負荷・ヒープ確保の出力間隔の既定値（0=出力しない、ヘッドレスは終了時に出力）
+// 設定（telemetry.report_interval_ms）に保存された値があればそちらを使う
+#ifndef APP_TASK_LOAD_REPORT_MS
+#if defined(EMULATOR_HEADLESS)
+#define APP_TASK_LOAD_REPORT_MS 0
+#else
+#define APP_TASK_LOAD_REPORT_MS 10000
+#endif
+#endif
+
+// LCD輝度の既定値（main.cpp の初期化と同じ）
+static const uint8_t DEFAULT_BRIGHTNESS = 200;
+
+// 設定（起動時に読み込み、変更は JOB_CONFIG_MS ごとにまとめて書き込む）
+static ConfigStore config_store;
 
 #ifndef APP_VERSION
 #define APP_VERSION "0.0.1"
@@ -71,47 +208,113 @@ static void format_build_datetime(char* out, int out_size)
 //      内部関数
 ///////////////////////////////////////////////////////////
 
+///////////////////////////////////////
+/// @brief 重量をサンプリングして最新値を公開
+/// @param add_history true なら履歴にも追加（校正中の値は履歴に残さない）
+static void sample_weight(bool add_history)
+{
+    Hardware& hw = hardware();
+
+    // 読み出し（HX711は変換待ちがあるため、トレンド画面を待たせないよう履歴のロックの外で行う）
+    {
+        std::lock_guard<std::mutex> lock(scale_mutex);
+        sensor_draft.weight_valid = hw.hasWeightSensor();
+        if (sensor_draft.weight_valid) {
+            sensor_draft.weight_grams = hw.getWeightGrams();
+        }
+    }
+    sensor_draft.weight_serial++;
+    sensor_draft.time_ms = lv_tick_get();
+    sensor_snapshot_publish(sensor_draft);
+
+    if (add_history && sensor_draft.weight_valid) {
+        std::lock_guard<std::mutex> lock(weight_mutex);
+        weight_history.add(sensor_draft.weight_grams, sensor_draft.time_ms);
+    }
+}
+
+///////////////////////////////////////
+/// @brief 校正画面から依頼された tare・校正を実行（計測タスク）
+static void run_scale_job(void)
+{
+    uint8_t job = scale_job.load(std::memory_order_acquire);
+    if (SCALE_JOB_TARE != job && SCALE_JOB_CALIBRATE != job) {
+        return;
+    }
+
+    Hardware& hw = hardware();
+    bool ok      = false;
+    {
+        std::lock_guard<std::mutex> lock(scale_mutex);
+        if (SCALE_JOB_TARE == job) {
+            ok = hw.tareWeightSensor();
+        } else {
+            ok              = hw.calibrateWeightSensor(CALIBRATION_GRAMS);
+            scale_job_scale = hw.getWeightScale();
+        }
+    }
+    scale_job.store(ok ? SCALE_JOB_DONE : SCALE_JOB_FAILED, std::memory_order_release);
+}
+
+///////////////////////////////////////
+/// @brief IMU・バッテリー・WiFiの状態を読み出して最新値を公開
+static void sample_status(void)
+{
+    Hardware& hw = hardware();
+
+    hw.getAccel(&sensor_draft.accel[0], &sensor_draft.accel[1], &sensor_draft.accel[2]);
+    hw.getGyro(&sensor_draft.gyro[0], &sensor_draft.gyro[1], &sensor_draft.gyro[2]);
+    sensor_draft.battery_voltage = hw.getBatteryVoltage();
+    sensor_draft.battery_level   = (int8_t)hw.getBatteryLevel();
+    sensor_draft.wifi_status     = hw.getWiFiStatus();
+    sensor_draft.time_ms         = lv_tick_get();
+    sensor_snapshot_publish(sensor_draft);
+}
+
 ///////////////////////////////////////
 /// @brief WiFi設定画面のUIを作成（APモード + QRコード表示）
 void create_screen_wifi_setup(void)
 {
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-    Serial.println("Creating WiFi setup screen (AP Mode + QR Code)...");
-#else
-    printf("Creating WiFi setup screen (AP Mode + QR Code)...\n");
-#endif
+    APP_LOGI("Creating WiFi setup screen (AP Mode + QR Code)...");
     
-    HardwareInterface* hw = getHardware();
+    Hardware& hw = hardware();
     
     // APモードで起動
-    String ap_ssid;
+    char ap_ssid[WIFI_SSID_SIZE];
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
     uint8_t mac[6];
     WiFi.macAddress(mac);
-    ap_ssid = String("M5Stick-") + String(mac[4], HEX) + String(mac[5], HEX);
-    ap_ssid.toUpperCase();
+    snprintf(ap_ssid, sizeof(ap_ssid), "M5Stick-%X%X", mac[4], mac[5]);
 #else
-    ap_ssid = "M5Stick-F1C8";
+    snprintf(ap_ssid, sizeof(ap_ssid), "M5Stick-F1C8");
 #endif
     
-    hw->startAPMode(ap_ssid);
+    hw.startAPMode(ap_ssid);
     
     // IPアドレス取得
-    String ip = hw->getIPAddress();
+    char ip[IP_ADDRESS_SIZE];
+    hw.getIPAddress(ip, sizeof(ip));
     
-    // Webサーバー起動
-    webServer = new WiFiWebServer();
-    webServer->begin(80);
+    // Webサーバー起動（リクエスト処理と停止はネットワークタスク、起動済みならそのまま使う）
+    if (nullptr == webServer.load()) {
+        {
+            std::lock_guard<std::mutex> lock(net_mutex);
+            wifi_received.received = false;
+        }
+        heap_audit_set_exempt(true);  // Arduinoの WebServer はリクエストごとにヒープを使う
+        WiFiWebServer* server = web_server_slot.create();
+        server->begin(80);
+        webServer.store(server);
+    }
     
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-    Serial.printf("AP Mode: SSID=%s, IP=%s\n", ap_ssid.c_str(), ip.c_str());
-#else
-    printf("AP Mode: SSID=%s, IP=%s\n", ap_ssid.c_str(), ip.c_str());
-#endif
+    APP_LOGI("AP Mode: SSID=%s, IP=%s", ap_ssid, ip);
     
     // QRコード生成（設定URLを含む）
-    String qr_text = "http://" + ip + "/";
-    QRCodeGenerator::generate(qr_text.c_str(), qrcode_size, qrcode_data);
+    char qr_text[32];
+    snprintf(qr_text, sizeof(qr_text), "http://%s/", ip);
+    if (!QRCodeGenerator::generate(qr_text, qrcode_data)) {
+        qrcode_data.size = 0;
+    }
     
     // UI作成
     lv_obj_t* scr = lv_scr_act();
@@ -129,66 +332,57 @@ void create_screen_wifi_setup(void)
     
     // SSID表示（緑文字）
     label_wifi_ssid = lv_label_create(scr);
-    lv_label_set_text_fmt(label_wifi_ssid, "SSID: %s", ap_ssid.c_str());
+    lv_label_set_text_fmt(label_wifi_ssid, "SSID: %s", ap_ssid);
     lv_obj_set_style_text_color(label_wifi_ssid, lv_color_make(0, 255, 0), LV_PART_MAIN);
     lv_obj_set_style_text_font(label_wifi_ssid, &lv_font_montserrat_20, LV_PART_MAIN);
     lv_obj_align(label_wifi_ssid, LV_ALIGN_TOP_LEFT, 5, 22);
     
     // QRコードキャンバス（右側）
-    int qr_scale = 2;  // 各モジュールのピクセル数
-    int canvas_size = qrcode_size * qr_scale + 8;  // マージン含む
+    // 各モジュールのピクセル数（80px四方に収まる最大値、バージョン3までは2倍）
+    const int qr_area = 80;
+    const int qr_margin = 4;
+    int qr_scale = (0 < qrcode_data.size) ? (qr_area - qr_margin * 2) / qrcode_data.size : 1;
+    if (qr_scale < 1) {
+        qr_scale = 1;
+    }
+    int canvas_size = qrcode_data.size * qr_scale + qr_margin * 2;  // マージン含む
     
-    static lv_color_t cbuf[80 * 80];  // キャンバスバッファ
+    // A8キャンバス：黒モジュールを不透明で描き、背景（白）に重ねる
+    // （I1はLVGLが描画のたびにARGB8888へ展開するため使わない）
+    alignas(LV_DRAW_BUF_ALIGN) static uint8_t cbuf[LV_CANVAS_BUF_SIZE(qr_area, qr_area, 8, LV_DRAW_BUF_STRIDE_ALIGN)];
     qrcode_canvas = lv_canvas_create(scr);
-    lv_canvas_set_buffer(qrcode_canvas, cbuf, canvas_size, canvas_size, LV_COLOR_FORMAT_RGB565);
-    lv_canvas_fill_bg(qrcode_canvas, lv_color_white(), LV_OPA_COVER);
+    lv_canvas_set_buffer(qrcode_canvas, cbuf, canvas_size, canvas_size, LV_COLOR_FORMAT_A8);
+    lv_obj_set_style_bg_color(qrcode_canvas, lv_color_white(), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(qrcode_canvas, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_set_style_image_recolor(qrcode_canvas, lv_color_black(), LV_PART_MAIN);
+    lv_obj_set_style_image_recolor_opa(qrcode_canvas, LV_OPA_COVER, LV_PART_MAIN);
     lv_obj_align(qrcode_canvas, LV_ALIGN_TOP_RIGHT, -30, 50);
     
     // QRコード描画（中央に配置）
-    int offset = 4;
-    for (uint8_t y = 0; y < qrcode_size; y++) {
-        for (uint8_t x = 0; x < qrcode_size; x++) {
-            lv_color_t color = qrcode_data[y][x] ? lv_color_black() : lv_color_white();
-            for (int sy = 0; sy < qr_scale; sy++) {
-                for (int sx = 0; sx < qr_scale; sx++) {
-                    lv_canvas_set_px(qrcode_canvas, offset + x * qr_scale + sx, 
-                                     offset + y * qr_scale + sy, color, LV_OPA_COVER);
-                }
-            }
-        }
-    }
+    QRCodeGenerator::drawToCanvas(qrcode_canvas, qrcode_data, qr_scale, qr_margin);
     
     // ステータス表示（黄色文字）
-    label_wifi_status = lv_label_create(scr);
-    lv_label_set_text(label_wifi_status, "Scan QR code\nwith smartphone");
-    lv_obj_set_style_text_color(label_wifi_status, lv_color_make(255, 255, 0), LV_PART_MAIN);
-    lv_obj_set_style_text_font(label_wifi_status, &lv_font_montserrat_14, LV_PART_MAIN);
-    lv_obj_align(label_wifi_status, LV_ALIGN_BOTTOM_LEFT, 5, -20);
+    label_wifi_status.bind(lv_label_create(scr));
+    label_wifi_status.set("Scan QR code\nwith smartphone");
+    label_wifi_status.setColor(lv_color_make(255, 255, 0));
+    lv_obj_set_style_text_font(label_wifi_status.getObject(), &lv_font_montserrat_14, LV_PART_MAIN);
+    lv_obj_align(label_wifi_status.getObject(), LV_ALIGN_BOTTOM_LEFT, 5, -20);
     
     // IPアドレス表示（シアン文字）
     label_wifi_ip = lv_label_create(scr);
-    lv_label_set_text_fmt(label_wifi_ip, "http://%s/", ip.c_str());
+    lv_label_set_text_fmt(label_wifi_ip, "http://%s/", ip);
     lv_obj_set_style_text_color(label_wifi_ip, lv_color_make(0, 255, 255), LV_PART_MAIN);
     lv_obj_set_style_text_font(label_wifi_ip, &lv_font_montserrat_14, LV_PART_MAIN);
     lv_obj_align(label_wifi_ip, LV_ALIGN_BOTTOM_LEFT, 5, -5);
     
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-    Serial.println("WiFi setup screen created with QR code");
-#else
-    printf("WiFi setup screen created with QR code\n");
-#endif
+    APP_LOGI("WiFi setup screen created with QR code");
 }
 
 ///////////////////////////////////////
 /// @brief スタート画面のUIを作成
 void create_screen_start(void)
 {
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-    Serial.println("Creating start screen UI...");
-    delay(100);
-#else
-    printf("Creating start screen UI...\n");
-#endif
+    APP_LOGI("Creating start screen UI...");
     
     // スクリーンオブジェクトを取得
     lv_obj_t* scr = lv_scr_act();
@@ -212,12 +406,7 @@ void create_screen_start(void)
     lv_obj_set_style_text_font(label_instruction, &lv_font_montserrat_26, LV_PART_MAIN);
     lv_obj_align(label_instruction, LV_ALIGN_CENTER, 0, 30);
     
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-    Serial.println("Start screen created successfully");
-    delay(100);
-#else
-    printf("Start screen created successfully\n");
-#endif
+    APP_LOGI("Start screen created successfully");
 }
 
 ///////////////////////////////////////
@@ -225,12 +414,7 @@ void create_screen_start(void)
 /// ボタン、重量情報を表示
 void create_screen_main(void)
 {
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-    Serial.println("Creating hardware demo UI...");
-    delay(100);
-#else
-    printf("Creating hardware demo UI...\n");
-#endif
+    APP_LOGI("Creating hardware demo UI...");
     
     // スクリーンオブジェクトを取得
     lv_obj_t* scr = lv_scr_act();
@@ -239,10 +423,7 @@ void create_screen_main(void)
     lv_obj_set_style_bg_color(scr, lv_color_black(), LV_PART_MAIN);
     lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, LV_PART_MAIN);
     
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-    Serial.println("Background set to BLACK");
-    delay(100);
-#endif
+    APP_LOGD("Background set to BLACK");
     
     // タイトル（白文字）
     lv_obj_t* label_title = lv_label_create(scr);
@@ -252,10 +433,7 @@ void create_screen_main(void)
     lv_obj_set_style_text_align(label_title, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
     lv_obj_align(label_title, LV_ALIGN_TOP_MID, 0, 0);
     
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-    Serial.println("Title created");
-    delay(100);
-#endif
+    APP_LOGD("Title created");
 
     // 重量
     label_weight_prefix = lv_label_create(scr);
@@ -264,10 +442,9 @@ void create_screen_main(void)
     lv_obj_set_style_text_font(label_weight_prefix, &lv_font_montserrat_20, LV_PART_MAIN);
     lv_obj_align(label_weight_prefix, LV_ALIGN_TOP_LEFT, 5, 40);
 
-    label_weight_value = lv_label_create(scr);
-    lv_label_set_text(label_weight_value, "--.--");
-    lv_obj_set_style_text_color(label_weight_value, lv_color_make(128, 128, 128), LV_PART_MAIN);
-    lv_obj_set_style_text_font(label_weight_value, &lv_font_montserrat_36, LV_PART_MAIN);
+    weight_digits.create(scr);
+    weight_digits.setColor(lv_color_make(128, 128, 128));
+    weight_digits.setText("--.--");
 
     label_weight_unit = lv_label_create(scr);
     lv_label_set_text(label_weight_unit, "[kg]");
@@ -276,35 +453,29 @@ void create_screen_main(void)
     lv_obj_align(label_weight_unit, LV_ALIGN_TOP_RIGHT, -5, 40);
 
     // [kg]の左側に1スペース分空けて、重さ表示を右揃え
-    lv_obj_align_to(label_weight_value, label_weight_unit, LV_ALIGN_OUT_LEFT_MID, -6, 0);
+    lv_obj_align_to(weight_digits.getObject(), label_weight_unit, LV_ALIGN_OUT_LEFT_MID, -6, 0);
+
+    // 数字の右端から "weight:" の右端（＋1スペース）までが、接頭辞を表示したまま数字を置ける幅
+    lv_obj_update_layout(scr);
+    weight_digits_room = lv_obj_get_x(weight_digits.getObject()) + WeightDigits::WIDTH -
+                         (lv_obj_get_x(label_weight_prefix) + lv_obj_get_width(label_weight_prefix) + 6);
 
-    label_status = lv_label_create(scr);
-    lv_label_set_text(label_status, "Press A or B");
-    lv_obj_set_style_text_color(label_status, lv_color_make(0, 255, 0), LV_PART_MAIN);
-    lv_obj_align(label_status, LV_ALIGN_TOP_LEFT, 5, 60);
+    // ステータスは数字の下（数字の高さ分下げる）
+    label_status.bind(lv_label_create(scr));
+    label_status.set("Press A or B");
+    label_status.setColor(lv_color_make(0, 255, 0));
+    lv_obj_align(label_status.getObject(), LV_ALIGN_TOP_LEFT, 5, 80);
     
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-    Serial.println("Status label created");
-    delay(100);
-#endif
+    APP_LOGD("Status label created");
     
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-    Serial.println("UI created successfully");
-    delay(100);
-#else
-    printf("UI created successfully\n");
-#endif
+    APP_LOGI("UI created successfully");
 }
 
 ///////////////////////////////////////
 /// @brief バージョン表示画面のUIを作成
 void create_screen_version(void)
 {
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-    Serial.println("Creating version screen UI...");
-#else
-    printf("Creating version screen UI...\n");
-#endif
+    APP_LOGI("Creating version screen UI...");
 
     lv_obj_t* scr = lv_scr_act();
 
@@ -341,11 +512,7 @@ void create_screen_version(void)
 /// @brief 重量センサー校正画面のUIを作成
 void create_screen_calibration(void)
 {
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-    Serial.println("Creating calibration screen UI...");
-#else
-    printf("Creating calibration screen UI...\n");
-#endif
+    APP_LOGI("Creating calibration screen UI...");
 
     lv_obj_t* scr = lv_scr_act();
 
@@ -358,361 +525,660 @@ void create_screen_calibration(void)
     lv_obj_set_style_text_font(label_title, &lv_font_montserrat_20, LV_PART_MAIN);
     lv_obj_align(label_title, LV_ALIGN_TOP_MID, 0, 5);
 
-    label_calib_status = lv_label_create(scr);
-    lv_label_set_text(label_calib_status, "A: tare (0g)\nB: calibrate 2000g\nA long: back");
-    lv_obj_set_style_text_color(label_calib_status, lv_color_make(0, 255, 0), LV_PART_MAIN);
-    lv_obj_set_style_text_font(label_calib_status, &lv_font_montserrat_14, LV_PART_MAIN);
-    lv_obj_align(label_calib_status, LV_ALIGN_TOP_LEFT, 5, 35);
+    label_calib_status.bind(lv_label_create(scr));
+    label_calib_status.set("A: tare (0g)\nB: calibrate 2000g\nA long: back");
+    label_calib_status.setColor(lv_color_make(0, 255, 0));
+    lv_obj_set_style_text_font(label_calib_status.getObject(), &lv_font_montserrat_14, LV_PART_MAIN);
+    lv_obj_align(label_calib_status.getObject(), LV_ALIGN_TOP_LEFT, 5, 35);
 
-    label_calib_weight = lv_label_create(scr);
-    lv_label_set_text(label_calib_weight, "Weight: --.- g");
-    lv_obj_set_style_text_color(label_calib_weight, lv_color_make(255, 255, 0), LV_PART_MAIN);
-    lv_obj_set_style_text_font(label_calib_weight, &lv_font_montserrat_20, LV_PART_MAIN);
-    lv_obj_align(label_calib_weight, LV_ALIGN_BOTTOM_LEFT, 5, -8);
+    // 最初のサンプルまでは仮表示（以降は値が変わった時だけ更新）
+    label_calib_weight.bind(lv_label_create(scr));
+    lv_label_set_text_static(label_calib_weight.getObject(), "Weight: --.- g");
+    label_calib_weight.setColor(lv_color_make(255, 255, 0));
+    lv_obj_set_style_text_font(label_calib_weight.getObject(), &lv_font_montserrat_20, LV_PART_MAIN);
+    lv_obj_align(label_calib_weight.getObject(), LV_ALIGN_BOTTOM_LEFT, 5, -8);
 }
 
 ///////////////////////////////////////
-/// @brief WiFi設定画面の更新（Webサーバー処理）
+/// @brief トレンドチャートに1分バケットを1点追加（左へシフト）
+static void trend_push_bucket(const WeightBucket& b)
+{
+    if (0 == b.count) {
+        // 欠測区間
+        lv_chart_set_next_value(trend_chart, trend_series_mean, LV_CHART_POINT_NONE);
+        lv_chart_set_next_value(trend_chart, trend_series_min, LV_CHART_POINT_NONE);
+        lv_chart_set_next_value(trend_chart, trend_series_max, LV_CHART_POINT_NONE);
+    } else {
+        lv_chart_set_next_value(trend_chart, trend_series_mean, (int32_t)b.mean);
+        lv_chart_set_next_value(trend_chart, trend_series_min, (int32_t)b.min);
+        lv_chart_set_next_value(trend_chart, trend_series_max, (int32_t)b.max);
+    }
+}
+
+///////////////////////////////////////
+/// @brief トレンドチャートのY軸範囲と集計ラベルを更新
+/// 直近1時間の集計は1分バケットから求める（O(バケット数)）
+static void trend_update_summary(void)
+{
+    WeightBucket hour;
+    uint16_t n = weight_history.summarize(WeightHistory::TIER_1MIN, WeightHistory::CAPACITY_1MIN, &hour);
+
+    if (0 == n || 0 == hour.count) {
+        hour.count = 0;
+        label_trend_value.set(hour);
+        return;
+    }
+
+    // Y軸上限は1kg単位で切り上げ（変化した時だけ設定）
+    int32_t range_max = ((int32_t)hour.max / 1000 + 1) * 1000;
+    if (range_max != trend_range_max) {
+        trend_range_max = range_max;
+        lv_chart_set_axis_range(trend_chart, LV_CHART_AXIS_PRIMARY_Y, 0, range_max);
+    }
+
+    label_trend_value.set(hour);
+}
+
+///////////////////////////////////////
+/// @brief トレンド画面のUIを作成
+/// 直近1時間の重量を1分バケット（平均・最小・最大）で表示
+void create_screen_trend(void)
+{
+    APP_LOGI("Creating trend screen UI...");
+
+    lv_obj_t* scr = lv_scr_act();
+
+    lv_obj_set_style_bg_color(scr, lv_color_black(), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, LV_PART_MAIN);
+
+    lv_obj_t* label_title = lv_label_create(scr);
+    lv_label_set_text(label_title, "Trend 1h [kg]");
+    lv_obj_set_style_text_color(label_title, lv_color_white(), LV_PART_MAIN);
+    lv_obj_set_style_text_font(label_title, &lv_font_montserrat_14, LV_PART_MAIN);
+    lv_obj_align(label_title, LV_ALIGN_TOP_LEFT, 5, 2);
+
+    label_trend_value.bind(lv_label_create(scr));
+    label_trend_value.setColor(lv_color_make(0, 255, 255));
+    lv_obj_set_style_text_font(label_trend_value.getObject(), &lv_font_montserrat_14, LV_PART_MAIN);
+    lv_obj_align(label_trend_value.getObject(), LV_ALIGN_TOP_LEFT, 5, 18);
+
+    // チャート（1分 x 60点、シフト更新）
+    trend_chart = lv_chart_create(scr);
+    lv_obj_set_size(trend_chart, lv_obj_get_width(scr) - 10, lv_obj_get_height(scr) - 42);
+    lv_obj_align(trend_chart, LV_ALIGN_BOTTOM_MID, 0, -4);
+    lv_obj_set_style_bg_color(trend_chart, lv_color_black(), LV_PART_MAIN);
+    lv_obj_set_style_border_color(trend_chart, lv_color_make(64, 64, 64), LV_PART_MAIN);
+    lv_obj_set_style_pad_all(trend_chart, 2, LV_PART_MAIN);
+    lv_obj_set_style_line_color(trend_chart, lv_color_make(48, 48, 48), LV_PART_MAIN);
+    lv_obj_set_style_line_width(trend_chart, 2, LV_PART_ITEMS);
+    lv_obj_set_style_size(trend_chart, 0, 0, LV_PART_INDICATOR);  // 点マーカーなし
+    lv_chart_set_type(trend_chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_div_line_count(trend_chart, 3, 0);
+    lv_chart_set_point_count(trend_chart, WeightHistory::CAPACITY_1MIN);
+    lv_chart_set_update_mode(trend_chart, LV_CHART_UPDATE_MODE_SHIFT);
+
+    trend_series_max  = lv_chart_add_series(trend_chart, lv_color_make(96, 96, 96), LV_CHART_AXIS_PRIMARY_Y);
+    trend_series_min  = lv_chart_add_series(trend_chart, lv_color_make(96, 96, 96), LV_CHART_AXIS_PRIMARY_Y);
+    trend_series_mean = lv_chart_add_series(trend_chart, lv_color_make(0, 255, 0), LV_CHART_AXIS_PRIMARY_Y);
+    lv_chart_set_all_value(trend_chart, trend_series_max, LV_CHART_POINT_NONE);
+    lv_chart_set_all_value(trend_chart, trend_series_min, LV_CHART_POINT_NONE);
+    lv_chart_set_all_value(trend_chart, trend_series_mean, LV_CHART_POINT_NONE);
+
+    // 既存の1分バケットを古い順に流し込む
+    std::lock_guard<std::mutex> lock(weight_mutex);
+    for (int age = weight_history.count(WeightHistory::TIER_1MIN) - 1; 0 <= age; age--) {
+        trend_push_bucket(weight_history.bucket(WeightHistory::TIER_1MIN, age));
+    }
+    trend_shown_serial = weight_history.closedSerial(WeightHistory::TIER_1MIN);
+    trend_range_max    = 0;
+    trend_update_summary();
+}
+
+///////////////////////////////////////
+/// @brief WiFi設定画面の更新
+/// Webサーバーで設定を受け取ったら保存して再起動（リクエスト処理とサーバーの停止はネットワークタスク）
 void update_wifi_setup(void)
 {
-    HardwareInterface* hw = getHardware();
-    
-    // Webサーバーのリクエスト処理（LVGLロック不要）
-    if (webServer) {
-        webServer->handleClient();
-        
-        // WiFi設定が完了したかチェック
-        if (webServer->isConfigured()) {
-            const char* ssid = webServer->getSSID();
-            const char* password = webServer->getPassword();
-            
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-            Serial.printf("WiFi configuration received: %s\n", ssid);
-#else
-            printf("WiFi configuration received: %s\n", ssid);
-#endif
-            
-            // 設定を保存
-            hw->saveWiFiConfig(ssid, password);
-            
-            // ステータス更新（LVGLロックが必要）
-            if (lvgl_port_lock()) {
-                lv_label_set_text(label_wifi_status, "Config saved!\nRebooting...");
-                lvgl_port_unlock();
-            }
-            
-            // Webサーバー停止
-            webServer->stop();
-            delete webServer;
-            webServer = nullptr;
-            
-            // APモード停止
-            hw->stopAPMode();
-            
-            // リブート
+    Hardware& hw = hardware();
+    char ssid[WIFI_SSID_SIZE];
+    char password[WIFI_PASSWORD_SIZE];
+
+    // WiFi設定を受け取ったかチェック
+    {
+        std::lock_guard<std::mutex> lock(net_mutex);
+        if (!wifi_received.received) {
+            return;
+        }
+        snprintf(ssid, sizeof(ssid), "%s", wifi_received.ssid);
+        snprintf(password, sizeof(password), "%s", wifi_received.password);
+        wifi_received.received = false;
+    }
+    heap_audit_set_exempt(false);
+
+    APP_LOGI("WiFi configuration received: %s", ssid);
+
+    // 設定を保存（リブートするので待たずに書き込む）
+    AppConfig& config = config_store.edit(lv_tick_get());
+    snprintf(config.wifi.ssid, sizeof(config.wifi.ssid), "%s", ssid);
+    snprintf(config.wifi.password, sizeof(config.wifi.password), "%s", password);
+    config_store.flushNow();
+
+    // ステータス更新（LVGLロックが必要）
+    if (lvgl_port_lock()) {
+        label_wifi_status.set("Config saved!\nRebooting...");
+        lvgl_port_unlock();
+    }
+
+    // APモード停止
+    hw.stopAPMode();
+
+    // リブート
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
-            delay(2000);
-            ESP.restart();
+    delay(2000);
+    ESP.restart();
 #else
-            // エミュレーターでは画面遷移のみ
-            printf("Simulating reboot...\n");
-            if (lvgl_port_lock()) {
-                lv_obj_clean(lv_scr_act());
-                create_screen_start();
-                current_screen = SCREEN_START;
-                lvgl_port_unlock();
-            }
-            
-            // WiFi接続を試行
-            hw->connectWiFi(ssid, password);
+    // エミュレーターでは画面遷移のみ
+    APP_LOGI("Simulating reboot...");
+    if (lvgl_port_lock()) {
+        screen_transition(SCREEN_START, "wifi configured");
+        lvgl_port_unlock();
+    }
+
+    // WiFi接続を試行
+    hw.connectWiFi(ssid, password);
 #endif
+}
+
+///////////////////////////////////////
+/// @brief メイン画面の重量表示を更新
+/// @param weight 重量 [g]
+/// @param valid 重量センサーが有効か
+void update_screen_main_weight(float weight, bool valid)
+{
+    char buf[32];
+
+    if (valid) {
+        float display_weight_kg = weight / 1000.0f;
+        if (display_weight_kg < 0.0f) {
+            display_weight_kg = 0.0f;
+        }
+        snprintf(buf, sizeof(buf), "%.2f", display_weight_kg);
+        if (5000.0f <= weight) {
+            // 5kg以上は白色で表示
+            weight_digits.setColor(lv_color_white());
+        } else if (1000.0f <= weight) {
+            // 1kg以上は黄色で表示
+            weight_digits.setColor(lv_color_make(0, 255, 255));
+        } else {
+            // 1kg未満は赤色で表示
+            weight_digits.setColor(lv_color_make(0, 255, 0));
         }
+        // 変化した桁だけが再描画される
+        weight_digits.setText(buf);
+    } else {
+        weight_digits.setColor(lv_color_make(128, 128, 128));
+        weight_digits.setText("--.--");
     }
-    
-    // 定期的にステータス更新（点滅効果）- LVGLロックが必要
-    static uint32_t last_blink = 0;
-    static bool blink_state = false;
-    
-    if (1000 < lv_tick_get() - last_blink) {
-        last_blink = lv_tick_get();
-        blink_state = !blink_state;
-        
-        if (lvgl_port_lock()) {
-            if (blink_state) {
-                lv_label_set_text(label_wifi_status, "► Scan QR code\nwith smartphone");
-            } else {
-                lv_label_set_text(label_wifi_status, "  Scan QR code\nwith smartphone");
-            }
-            lvgl_port_unlock();
+
+    // 桁数が増えて数字が "weight:" に重なるなら接頭辞を隠す（単位の [kg] は常に表示）
+    bool hide_prefix = weight_digits_room < weight_digits.getTextWidth();
+    if (hide_prefix != lv_obj_has_flag(label_weight_prefix, LV_OBJ_FLAG_HIDDEN)) {
+        if (hide_prefix) {
+            lv_obj_add_flag(label_weight_prefix, LV_OBJ_FLAG_HIDDEN);
+        } else {
+            lv_obj_remove_flag(label_weight_prefix, LV_OBJ_FLAG_HIDDEN);
         }
     }
 }
 
 ///////////////////////////////////////
 /// @brief メイン画面の更新
-/// ボタン押下、重量情報を更新
+/// 長押し中の表示、重量情報を更新
 void update_screen_main(void)
 {
-    HardwareInterface* hw = getHardware();
-    hw->update();
-    
     char buf[128];
-    static uint32_t counter = 0;
-    static uint32_t button_a_press_start = 0;
-    static bool button_a_long_press_triggered = false;
-    static uint32_t button_b_press_start = 0;
-    static bool button_b_long_press_triggered = false;
-
-    // Aボタン長押しチェック（バージョン画面へ遷移）
-    if (hw->isButtonAPressed()) {
-        if (0 == button_a_press_start) {
-            button_a_press_start = lv_tick_get();
-            button_a_long_press_triggered = false;
-        } else {
-            uint32_t press_duration = lv_tick_get() - button_a_press_start;
-            if (1500 < press_duration && !button_a_long_press_triggered) {
-                button_a_long_press_triggered = true;
+    static uint32_t shown_serial = 0;
 
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-                Serial.println("Button A long press detected - transitioning to version screen");
-#else
-                printf("Button A long press detected - transitioning to version screen\n");
-#endif
+    // B長押し中の視覚的フィードバック
+    uint32_t held = button_gestures.heldMs(ButtonEvent::B, lv_tick_get());
+    if (0 < held) {
+        snprintf(buf, sizeof(buf), "Hold B: %d/3s", (int)(held / 1000) + 1);
+        label_status.set(buf);
+    }
 
-                lv_obj_clean(lv_scr_act());
-                create_screen_version();
-                current_screen = SCREEN_VERSION;
+    // 重量表示（新しいサンプルがあれば更新）
+    SensorSnapshot snapshot;
+    sensor_snapshot_read(&snapshot);
+    if (shown_serial != snapshot.weight_serial) {
+        shown_serial = snapshot.weight_serial;
+        update_screen_main_weight(snapshot.weight_grams, snapshot.weight_valid);
+    }
+}
 
-                button_a_press_start = 0;
-                return;
-            }
-        }
-    } else {
-        // ボタンが離された
-        if (0 != button_a_press_start && !button_a_long_press_triggered) {
-            // 短押しの処理
-            lv_label_set_text(label_status, "Button A pressed!");
+///////////////////////////////////////
+/// @brief LCD輝度を反映
+static void apply_brightness(uint8_t brightness)
+{
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
-            Serial.println("Button A pressed!");
+    extern M5GFX gfx;
+    gfx.setBrightness(brightness);
 #else
-            printf("Button A pressed!\n");
+    hardware().setBrightness(brightness);
 #endif
-        }
-        button_a_press_start = 0;
-        button_a_long_press_triggered = false;
+    APP_LOGI("Brightness set to %d", brightness);
+}
+
+///////////////////////////////////////
+/// @brief メイン画面のボタン操作
+/// B短押し：明るさ変更、B長押し：WiFi設定リセット（画面遷移は SCREEN_TRANSITIONS）
+static void gesture_screen_main(const Gesture& gesture)
+{
+    if (ButtonEvent::B != gesture.button) {
+        return;
     }
-    
-    // Bボタン長押しチェック（WiFi設定リセット）
-    if (hw->isButtonBPressed()) {
-        if (0 == button_b_press_start) {
-            // 押され始めた時刻を記録
-            button_b_press_start = lv_tick_get();
-            button_b_long_press_triggered = false;
-        } else {
-            // 長押し判定（3秒以上）
-            uint32_t press_duration = lv_tick_get() - button_b_press_start;
-            if (3000 < press_duration && !button_b_long_press_triggered) {
-                button_b_long_press_triggered = true;
-                
-                lv_label_set_text(label_status, "WiFi Reset!\nRebooting...");
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-                Serial.println("Button B long press detected - resetting WiFi config");
-#else
-                printf("Button B long press detected - resetting WiFi config\n");
-#endif
-                
-                // WiFi設定をクリア
-                hw->clearWiFiConfig();
-                
-                // リブート
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-                delay(1000);
-                ESP.restart();
-#else
-                // エミュレーターでは画面遷移のみ
-                printf("Simulating reboot to WiFi setup screen...\n");
-                lv_obj_clean(lv_scr_act());
-                create_screen_wifi_setup();
-                current_screen = SCREEN_WIFI_SETUP;
-                button_b_press_start = 0;
-                return;
-#endif
-            } else if (!button_b_long_press_triggered) {
-                // 長押し中の視覚的フィードバック
-                snprintf(buf, sizeof(buf), "Hold B: %d/3s", (int)(press_duration / 1000) + 1);
-                lv_label_set_text(label_status, buf);
-            }
-        }
-    } else {
-        // ボタンが離された
-        if (0 != button_b_press_start && !button_b_long_press_triggered) {
-            // 短押しの処理（明るさ変更）
-            lv_label_set_text(label_status, "Button B pressed!");
+    if (GestureType::SHORT == gesture.type) {
+        // 短押しの処理（明るさ変更）
+        label_status.set("Button B pressed!");
+        APP_LOGI("Button B pressed!");
+        // 連打しても書き込みは最後の変更から ConfigStore::COALESCE_MS 後の1回
+        AppConfig& config = config_store.edit(lv_tick_get());
+        config.display.brightness += 64;
+        apply_brightness(config.display.brightness);
+    } else if (GestureType::LONG == gesture.type) {
+        label_status.set("WiFi Reset!\nRebooting...");
+        APP_LOGI("Button B long press detected - resetting WiFi config");
+
+        // WiFi設定をクリア（リブートするので待たずに書き込む）
+        AppConfig& config = config_store.edit(lv_tick_get());
+        memset(&config.wifi, 0, sizeof(config.wifi));
+        config_store.flushNow();
+
+        // リブート
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
-            Serial.println("Button B pressed!");
-            
-            extern M5GFX gfx;
-            static uint8_t brightness = 128;
-            brightness += 64;
-            gfx.setBrightness(brightness);
-            Serial.printf("Brightness set to %d\n", brightness);
+        delay(1000);
+        ESP.restart();
 #else
-            printf("Button B pressed!\n");
-            static uint8_t brightness = 128;
-            brightness += 64;
-            hw->setBrightness(brightness);
+        // エミュレーターでは画面遷移のみ
+        APP_LOGI("Simulating reboot to WiFi setup screen...");
+        screen_transition(SCREEN_WIFI_SETUP, "wifi reset");
 #endif
-        }
-        button_b_press_start = 0;
-        button_b_long_press_triggered = false;
     }
-    
-    // 重量表示（10回に1回更新）
-    if (0 == counter % 10) {
-        if (hw->hasWeightSensor()) {
-            float weight = hw->getWeightGrams();
-            float display_weight_kg = weight / 1000.0f;
-            if (display_weight_kg < 0.0f) {
-                display_weight_kg = 0.0f;
-            }
-            snprintf(buf, sizeof(buf), "%.2f", display_weight_kg);
-            if (5000.0f <= weight) {
-                // 5kg以上は白色で表示
-                lv_obj_set_style_text_color(label_weight_value, lv_color_white(), LV_PART_MAIN);
-            } else if (1000.0f <= weight) {
-                // 1kg以上は黄色で表示
-                lv_obj_set_style_text_color(label_weight_value, lv_color_make(0, 255, 255), LV_PART_MAIN);
-            } else {
-                // 1kg未満は赤色で表示
-                lv_obj_set_style_text_color(label_weight_value, lv_color_make(0, 255, 0), LV_PART_MAIN);
-            }
-            lv_label_set_text(label_weight_value, buf);
-            lv_obj_align_to(label_weight_value, label_weight_unit, LV_ALIGN_OUT_LEFT_MID, -6, 0);
-        } else {
-            lv_obj_set_style_text_color(label_weight_value, lv_color_make(128, 128, 128), LV_PART_MAIN);
-            lv_label_set_text(label_weight_value, "--.--");
-            lv_obj_align_to(label_weight_value, label_weight_unit, LV_ALIGN_OUT_LEFT_MID, -6, 0);
-        }
+}
+
+///////////////////////////////////////
+/// @brief 重量センサー校正画面の更新
+/// 計測タスクが tare・校正を終えていれば結果を表示する
+void update_screen_calibration(void)
+{
+    SensorSnapshot snapshot;
+    sensor_snapshot_read(&snapshot);
+    label_calib_weight.set(snapshot.weight_valid ? snapshot.weight_grams : NAN);
+
+    uint8_t result = scale_job.load(std::memory_order_acquire);
+    if (SCALE_JOB_DONE != result && SCALE_JOB_FAILED != result) {
+        return;
     }
-    
-    if (0x09U <= counter) {
-        counter = 0;
+    bool ok = (SCALE_JOB_DONE == result);
+    if (SCALE_JOB_TARE == scale_job_requested) {
+        label_calib_status.set(ok ? "Tare done\nPlace 2000g\nPress B to calibrate"
+                                  : "Tare failed\nCheck sensor connection");
+    } else if (ok) {
+        config_store.edit(lv_tick_get()).calibration.scale = scale_job_scale;
+        label_calib_status.set("Calibrated (2000g)\nA long: back");
     } else {
-        counter++;
+        label_calib_status.set("Calibration failed\nPlace 2000g and retry");
     }
+    scale_job_requested = SCALE_JOB_NONE;
+    scale_job.store(SCALE_JOB_NONE, std::memory_order_relaxed);
 }
 
 ///////////////////////////////////////
-/// @brief 重量センサー校正画面の更新
-void update_screen_calibration(void)
+/// @brief 重量センサー校正画面のボタン操作
+/// A短押し：tare、B短押し：2000gで校正（A長押しでメイン画面へ戻るのは SCREEN_TRANSITIONS）
+/// 実行は計測タスクに依頼し、結果は update_screen_calibration() で表示する（実行中の操作は無視）
+static void gesture_screen_calibration(const Gesture& gesture)
 {
-    HardwareInterface* hw = getHardware();
-    static uint32_t button_a_press_start = 0;
-    static bool button_a_long_press_triggered = false;
-    static uint32_t counter = 0;
+    if (GestureType::SHORT != gesture.type || SCALE_JOB_NONE != scale_job.load(std::memory_order_relaxed)) {
+        return;
+    }
 
-    if (hw->isButtonAPressed()) {
-        if (0 == button_a_press_start) {
-            button_a_press_start = lv_tick_get();
-            button_a_long_press_triggered = false;
-        } else {
-            uint32_t press_duration = lv_tick_get() - button_a_press_start;
-            if (1500 < press_duration && !button_a_long_press_triggered) {
-                button_a_long_press_triggered = true;
-                lv_obj_clean(lv_scr_act());
-                create_screen_main();
-                current_screen = SCREEN_MAIN;
-                button_a_press_start = 0;
-                return;
-            }
-        }
+    if (ButtonEvent::A == gesture.button) {
+        label_calib_status.set("Taring...");
+        scale_job_requested = SCALE_JOB_TARE;
     } else {
-        if (0 != button_a_press_start && !button_a_long_press_triggered) {
-            if (hw->tareWeightSensor()) {
-                lv_label_set_text(label_calib_status, "Tare done\nPlace 2000g\nPress B to calibrate");
-            } else {
-                lv_label_set_text(label_calib_status, "Tare failed\nCheck sensor connection");
-            }
-        }
-        button_a_press_start = 0;
-        button_a_long_press_triggered = false;
+        label_calib_status.set("Calibrating...");
+        scale_job_requested = SCALE_JOB_CALIBRATE;
     }
+    scale_job.store(scale_job_requested, std::memory_order_release);
+}
 
-    if (hw->wasButtonBPressed()) {
-        if (hw->calibrateWeightSensor(2000.0f)) {
-            lv_label_set_text(label_calib_status, "Calibrated (2000g)\nA long: back");
-        } else {
-            lv_label_set_text(label_calib_status, "Calibration failed\nPlace 2000g and retry");
+///////////////////////////////////////
+/// @brief トレンド画面の更新
+/// 1分バケットが確定した分だけチャートを1点ずつシフト
+void update_screen_trend(void)
+{
+    std::lock_guard<std::mutex> lock(weight_mutex);
+    uint32_t serial = weight_history.closedSerial(WeightHistory::TIER_1MIN);
+    if (serial == trend_shown_serial) {
+        return;
+    }
+
+    uint32_t added = serial - trend_shown_serial;
+    if (WeightHistory::CAPACITY_1MIN < added) {
+        added = WeightHistory::CAPACITY_1MIN;
+    }
+    for (int age = (int)added - 1; 0 <= age; age--) {
+        trend_push_bucket(weight_history.bucket(WeightHistory::TIER_1MIN, age));
+    }
+    trend_shown_serial = serial;
+    trend_update_summary();
+}
+
+
+///////////////////////////////////////
+/// @brief トレンド画面の終了
+/// 削除されるチャートへの参照を外す
+static void exit_screen_trend(void)
+{
+    trend_chart       = nullptr;
+    trend_series_mean = nullptr;
+    trend_series_min  = nullptr;
+    trend_series_max  = nullptr;
+}
+
+///////////////////////////////////////////////////////////
+//      画面の状態遷移
+///////////////////////////////////////////////////////////
+
+/**
+ * @brief 画面の定義
+ * 画面ごとの開始・終了・周期処理・ボタン操作の関数と周期処理の間隔。
+ * 周期処理のない画面（tick_ms=0）はループで何も実行しない。
+ */
+struct ScreenDef {
+    AppScreen id;
+    const char* name;
+    void (*on_enter)(void);                    // 画面の作成（LVGLロック内）
+    void (*on_exit)(void);                     // 画面の削除前（LVGLロック内、nullptr=なし）
+    void (*on_tick)(void);                     // 周期処理（nullptr=なし）
+    void (*on_event)(const Gesture& gesture);  // 遷移以外のボタン操作（LVGLロック内、nullptr=なし）
+    uint32_t tick_ms;                          // 周期処理の間隔 [ms]
+    bool tick_locks_lvgl;                      // 周期処理をLVGLロック内で呼ぶか
+    WeightSampling sampling;                   // 表示中の重量サンプリング（計測タスク）
+};
+
+static constexpr ScreenDef SCREENS[SCREEN_COUNT] = {
+    {SCREEN_WIFI_SETUP, "WIFI_SETUP", create_screen_wifi_setup, nullptr, update_wifi_setup, nullptr, 100, false,
+     SAMPLING_OFF},
+    {SCREEN_START, "START", create_screen_start, nullptr, nullptr, nullptr, 0, true, SAMPLING_OFF},
+    {SCREEN_MAIN, "MAIN", create_screen_main, nullptr, update_screen_main, gesture_screen_main, 50, true,
+     SAMPLING_HISTORY},
+    {SCREEN_VERSION, "VERSION", create_screen_version, nullptr, nullptr, nullptr, 0, true, SAMPLING_OFF},
+    {SCREEN_CALIBRATION, "CALIBRATION", create_screen_calibration, nullptr, update_screen_calibration,
+     gesture_screen_calibration, 100, true, SAMPLING_LIVE},
+    {SCREEN_TREND, "TREND", create_screen_trend, exit_screen_trend, update_screen_trend, nullptr, 1000, true,
+     SAMPLING_HISTORY},
+};
+
+constexpr bool screens_in_order(int i)
+{
+    return (SCREEN_COUNT <= i) || (SCREENS[i].id == i && screens_in_order(i + 1));
+}
+static_assert(screens_in_order(0), "SCREENS must be indexed by AppScreen");
+
+/**
+ * @brief ボタン操作による画面遷移
+ */
+struct ScreenTransition {
+    AppScreen from;
+    GestureType type;
+    uint8_t button;
+    AppScreen to;
+};
+
+static constexpr ScreenTransition SCREEN_TRANSITIONS[] = {
+    {SCREEN_START, GestureType::SHORT, ButtonEvent::A, SCREEN_MAIN},
+    {SCREEN_MAIN, GestureType::SHORT, ButtonEvent::A, SCREEN_TREND},
+    {SCREEN_MAIN, GestureType::LONG, ButtonEvent::A, SCREEN_VERSION},
+    {SCREEN_VERSION, GestureType::SHORT, ButtonEvent::A, SCREEN_CALIBRATION},
+    {SCREEN_VERSION, GestureType::SHORT, ButtonEvent::B, SCREEN_MAIN},
+    {SCREEN_CALIBRATION, GestureType::LONG, ButtonEvent::A, SCREEN_MAIN},
+    {SCREEN_TREND, GestureType::SHORT, ButtonEvent::A, SCREEN_MAIN},
+};
+
+static const char* const GESTURE_NAMES[] = {"short", "long", "double", "chord", "repeat"};
+
+///////////////////////////////////////
+/// @brief 画面を遷移する（LVGLロック内で呼ぶ）
+/// 現在の画面の on_exit → 画面の削除 → 次の画面の on_enter の順に実行し、遷移と所要時間をログに出す。
+/// 認識中のボタン操作は破棄し、押したままのボタンは離すまで無視する。
+static void screen_transition(AppScreen next, const char* reason)
+{
+    const char* from = (current_screen < SCREEN_COUNT) ? SCREENS[current_screen].name : "-";
+    uint32_t start_us = app_clock_micros();
+
+    if (current_screen < SCREEN_COUNT && SCREENS[current_screen].on_exit) {
+        SCREENS[current_screen].on_exit();
+    }
+    lv_obj_clean(lv_scr_act());
+    current_screen = next;
+    weight_sampling.store(SCREENS[next].sampling, std::memory_order_relaxed);
+    SCREENS[next].on_enter();
+    scheduler.setPeriod(job_screen, SCREENS[next].tick_ms, lv_tick_get(), true);  // 次のループで最初の周期処理
+    button_gestures.reset();
+
+    uint32_t elapsed_us = app_clock_micros() - start_us;
+    APP_LOGI("Screen: %s -> %s (%s, %lu us)", from, SCREENS[next].name, reason, (unsigned long)elapsed_us);
+}
+
+///////////////////////////////////////
+/// @brief ボタンをLVGLのキーパッドとして読み出す
+/// job_buttons() が lv_indev_read() の前に置いたデバウンス済みのエッジを返す
+/// （フォーカス可能なオブジェクトはデフォルトグループで操作される）
+static void button_indev_read_cb(lv_indev_t* indev, lv_indev_data_t* data)
+{
+    data->key   = (ButtonEvent::A == button_indev_event.button) ? LV_KEY_ENTER : LV_KEY_NEXT;
+    data->state = button_indev_event.pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+///////////////////////////////////////
+/// @brief ボタン操作を現在の画面に振り分ける（LVGLロック内で呼ぶ）
+/// A+B同時押しはどの画面でも描画性能オーバーレイの表示切り替え。
+/// SCREEN_TRANSITIONS に一致すれば画面遷移、それ以外は画面の on_event へ渡す。
+static void dispatch_gesture(const Gesture& gesture)
+{
+    if (GestureType::CHORD == gesture.type) {
+        lvgl_port_perf_overlay_toggle();
+        return;
+    }
+
+    for (const ScreenTransition& t : SCREEN_TRANSITIONS) {
+        if (t.from == current_screen && t.type == gesture.type && t.button == gesture.button) {
+            char reason[16];
+            snprintf(reason, sizeof(reason), "%c %s", (ButtonEvent::A == gesture.button) ? 'A' : 'B',
+                     GESTURE_NAMES[(int)gesture.type]);
+            screen_transition(t.to, reason);
+            return;
         }
     }
 
-    if (0 == counter % 10) {
-        if (hw->hasWeightSensor()) {
-            char buf[64];
-            float w = hw->getWeightGrams();
-            snprintf(buf, sizeof(buf), "Weight: %.1f g", w);
-            lv_label_set_text(label_calib_weight, buf);
-        } else {
-            lv_label_set_text(label_calib_weight, "Weight: sensor N/A");
+    if (current_screen < SCREEN_COUNT && SCREENS[current_screen].on_event) {
+        SCREENS[current_screen].on_event(gesture);
+    }
+}
+
+///////////////////////////////////////
+/// @brief ジョブ：ボタン走査
+/// ハードウェアを更新し、ボタンイベントから認識した操作を現在の画面へ振り分ける
+static void job_buttons(void)
+{
+    Hardware& hw = hardware();
+    hw.update();
+
+    ButtonEvent event;
+    while (hw.popButtonEvent(&event)) {
+        button_gestures.onEvent(event);
+        if (button_indev && lvgl_port_lock()) {
+            button_indev_event = event;
+            lv_indev_read(button_indev);
+            lvgl_port_unlock();
         }
     }
+    button_gestures.update(lv_tick_get());
+    Gesture gesture;
+    while (button_gestures.pop(&gesture)) {
+        if (lvgl_port_lock()) {
+            dispatch_gesture(gesture);
+            lvgl_port_unlock();
+        }
+    }
+}
 
-    if (0x09U <= counter) {
-        counter = 0;
-    } else {
-        counter++;
+///////////////////////////////////////
+/// @brief ジョブ：校正画面から依頼された tare・校正と、重量サンプリング（計測を使う画面のみ、画面は weight_sampling で知る）
+static void job_weight(void)
+{
+    run_scale_job();
+
+    uint8_t sampling = weight_sampling.load(std::memory_order_relaxed);
+    if (SAMPLING_OFF != sampling) {
+        sample_weight(SAMPLING_HISTORY == sampling);
     }
 }
 
 ///////////////////////////////////////
-/// @brief スタート画面の更新
-void update_screen_start(void)
+/// @brief ジョブ：画面の周期処理（周期は SCREENS の tick_ms、周期処理のない画面では停止）
+static void job_screen_tick(void)
 {
-    HardwareInterface* hw = getHardware();
+    if (SCREEN_COUNT <= current_screen || nullptr == SCREENS[current_screen].on_tick) {
+        return;
+    }
+    const ScreenDef& screen = SCREENS[current_screen];
+    if (!screen.tick_locks_lvgl) {
+        screen.on_tick();  // WiFi設定画面：Webサーバー処理（必要な箇所だけ自分でロック）
+    } else if (lvgl_port_lock()) {
+        screen.on_tick();
+        lvgl_port_unlock();
+    }
+}
 
-    // Aボタン短押しでメイン画面へ遷移
-    if (hw->wasButtonAPressed()) {
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-    Serial.println("Button A pressed - transitioning to main screen");
-#else
-    printf("Button A pressed - transitioning to main screen\n");
-#endif
-    lv_obj_clean(lv_scr_act());
-    create_screen_main();
-    current_screen = SCREEN_MAIN;
+///////////////////////////////////////
+/// @brief ジョブ：Webサーバーのリクエスト処理（ネットワークタスク）
+/// サーバーにはこのタスクだけが触るためロックせずに処理し、受け取った設定を渡すときだけ net_mutex を取る
+/// （WebServer は受信を通知しないため周期的に呼ぶ）
+static void job_web(void)
+{
+    WiFiWebServer* server = webServer.load();
+    if (nullptr == server) {
+        return;
     }
+    server->handleClient();
+    if (!server->isConfigured()) {
+        return;
+    }
+
+    // 設定を受け取ったらサーバーを停止し、設定を画面へ渡す
+    char ssid[WIFI_SSID_SIZE];
+    char password[WIFI_PASSWORD_SIZE];
+    snprintf(ssid, sizeof(ssid), "%s", server->getSSID());
+    snprintf(password, sizeof(password), "%s", server->getPassword());
+    server->stop();
+    web_server_slot.destroy();
+    webServer.store(nullptr);  // 破棄を終えてから公開をやめる（画面が次のサーバーを同じ領域に作れる）
+
+    std::lock_guard<std::mutex> lock(net_mutex);
+    snprintf(wifi_received.ssid, sizeof(wifi_received.ssid), "%s", ssid);
+    snprintf(wifi_received.password, sizeof(wifi_received.password), "%s", password);
+    wifi_received.received = true;
 }
 
 ///////////////////////////////////////
-/// @brief バージョン画面の更新
-void update_screen_version(void)
+/// @brief ジョブ：WiFi設定画面のステータス点滅
+static void job_blink(void)
 {
-    HardwareInterface* hw = getHardware();
+    static bool blink_state = false;
+    if (SCREEN_WIFI_SETUP != current_screen) {
+        return;
+    }
 
-    // Aボタン短押しでキャリブレーション画面へ遷移
-    if (hw->wasButtonAPressed()) {
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-        Serial.println("Button A short press - transitioning to calibration screen");
-#else
-        printf("Button A short press - transitioning to calibration screen\n");
-#endif
-        lv_obj_clean(lv_scr_act());
-        create_screen_calibration();
-        current_screen = SCREEN_CALIBRATION;
+    blink_state = !blink_state;
+    if (lvgl_port_lock()) {
+        if (blink_state) {
+            label_wifi_status.set("► Scan QR code\nwith smartphone");
+        } else {
+            label_wifi_status.set("  Scan QR code\nwith smartphone");
+        }
+        lvgl_port_unlock();
     }
-    // Bボタン短押しでメイン画面へ遷移
-    else if (hw->wasButtonBPressed()) {
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-        Serial.println("Button B short press - returning to main screen");
-#else
-        printf("Button B short press - returning to main screen\n");
-#endif
-        lv_obj_clean(lv_scr_act());
-        create_screen_main();
-        current_screen = SCREEN_MAIN;
+}
+
+///////////////////////////////////////
+/// @brief ジョブ：設定の変更をまとめて書き込む
+static void job_config(void)
+{
+    config_store.flush(lv_tick_get());
+}
+
+///////////////////////////////////////
+/// @brief ジョブ：タスクごとのCPU負荷、ヒープ確保、ラベル更新（省略した無効化）の出力
+static void job_report(void)
+{
+    app_task_print_load();
+    heap_audit_print();
+    BoundLabelBase::printStats();
+}
+
+///////////////////////////////////////
+/// @brief スケジューラーを回すタスク（計測・ネットワーク）
+static void scheduler_task(void* arg)
+{
+    SchedulerTask* task = (SchedulerTask*)arg;
+    while (1) {
+        uint32_t wait_ms = task->scheduler.runDue(lv_tick_get(), LOOP_MAX_WAIT_MS);
+        app_task_add_busy(task->id, task->scheduler.takeBusyUs());
+        app_clock_sleep_ms(wait_ms);
     }
 }
 
+///////////////////////////////////////
+/// @brief 設定の保存先（ConfigStore から呼ばれる）
+static size_t config_load(void* data, size_t size)
+{
+    return hardware().loadConfig(data, size);
+}
+
+static bool config_save(const void* data, size_t size)
+{
+    return hardware().saveConfig(data, size);
+}
+
+///////////////////////////////////////
+/// @brief 設定を読み込んで反映する（起動時に1回）
+/// 保存された設定がなければ旧形式のWiFi設定を取り込む
+static void load_config(void)
+{
+    Hardware& hw = hardware();
+
+    AppConfig defaults;
+    memset(&defaults, 0, sizeof(defaults));
+    defaults.display.brightness           = DEFAULT_BRIGHTNESS;
+    defaults.telemetry.report_interval_ms = APP_TASK_LOAD_REPORT_MS;
+
+    if (!config_store.begin(config_load, config_save, defaults)) {
+        char ssid[WIFI_SSID_SIZE];
+        char password[WIFI_PASSWORD_SIZE];
+        if (hw.loadWiFiConfig(ssid, sizeof(ssid), password, sizeof(password))) {
+            AppConfig& config = config_store.edit(lv_tick_get());
+            snprintf(config.wifi.ssid, sizeof(config.wifi.ssid), "%s", ssid);
+            snprintf(config.wifi.password, sizeof(config.wifi.password), "%s", password);
+            APP_LOGI("Config: imported legacy WiFi config");
+        }
+    }
+
+    const AppConfig& config = config_store.get();
+    hw.setWeightScale(config.calibration.scale);
+    apply_brightness(config.display.brightness);
+}
 
 ///////////////////////////////////////////////////////////
 //      外部関数
@@ -723,122 +1189,132 @@ void update_screen_version(void)
 /// WiFi設定をチェックしてから適切な画面を表示
 void user_app_setup(void)
 {
-    HardwareInterface* hw = getHardware();
+    // 以降のログは優先度の低いログタスクが出力する
+    log_threaded = app_task_start(APP_TASK_LOG, app_log_task, nullptr);
+
+    hardware_begin();  // setup() で初期化済みなら何もしない（SDLエミュレーターはここで初期化）
+    Hardware& hw = hardware();
+
+    APP_LOGI("Weight history: %u bytes", (unsigned)WeightHistory::memoryBytes());
+
+    ButtonGestures::Config gesture_config;
+    gesture_config.long_ms[ButtonEvent::A] = BUTTON_A_LONG_MS;
+    gesture_config.long_ms[ButtonEvent::B] = BUTTON_B_LONG_MS;
+    gesture_config.double_ms               = 0;  // ダブル押しは使わない（短押しを離した時点で確定）
+    gesture_config.repeat_ms               = 0;
+    button_gestures.configure(gesture_config);
+
+    load_config();
+    const AppConfig& config = config_store.get();
+
+    // 周期ジョブ（画面の周期処理は画面遷移時に周期を設定）
+    app_task_adopt(APP_TASK_APP);
+    uint32_t now = lv_tick_get();
+    scheduler.add("buttons", job_buttons, JOB_BUTTONS_MS, now);
+    job_screen = scheduler.add("screen", job_screen_tick, 0, now);
+    scheduler.add("blink", job_blink, JOB_BLINK_MS, now);
+    scheduler.add("config", job_config, JOB_CONFIG_MS, now);
+    int job_load = scheduler.add("load", job_report, 0, now);
+    scheduler.setPeriod(job_load, config.telemetry.report_interval_ms, now, false);
+    sensor_task.scheduler.add("weight", job_weight, JOB_WEIGHT_MS, now);
+    sensor_task.scheduler.add("status", sample_status, JOB_STATUS_MS, now);
+    net_task.scheduler.add("web", job_web, JOB_WEB_MS, now);
+
+    // ボタンをキーパッド入力として登録（タッチパネルはないためポインター入力は作らない）
+    if (lvgl_port_lock()) {
+        button_indev = lv_indev_create();
+        lv_indev_set_type(button_indev, LV_INDEV_TYPE_KEYPAD);
+        lv_indev_set_read_cb(button_indev, button_indev_read_cb);
+        lv_indev_set_mode(button_indev, LV_INDEV_MODE_EVENT);
+        lv_group_t* group = lv_group_create();
+        lv_group_set_default(group);
+        lv_indev_set_group(button_indev, group);
+        lvgl_port_unlock();
+    }
     
     // WiFi設定の有無をチェック
-    if (hw->hasWiFiConfig()) {
+    if ('\0' != config.wifi.ssid[0]) {
         // WiFi設定がある場合、自動接続を試みる
-        String ssid;
-        String password;
+        APP_LOGI("WiFi config found: %s", config.wifi.ssid);
+        APP_LOGI("Attempting to connect...");
         
-        if (hw->loadWiFiConfig(ssid, password)) {
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-            Serial.printf("WiFi config found: %s\n", ssid.c_str());
-            Serial.println("Attempting to connect...");
-#else
-            printf("WiFi config found: %s\n", ssid.c_str());
-            printf("Attempting to connect...\n");
-#endif
-            
-            hw->connectWiFi(ssid, password);
-            
-            // 接続結果を待つ（最大5秒）
-            for (int cnt = 0; cnt < 50; cnt++) {
-                hw->update();
-                if (hw->getWiFiStatus() == WiFiStatus::CONNECTED) {
-                    String ip = hw->getIPAddress();
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-                    Serial.printf("WiFi connected! IP: %s\n", ip.c_str());
-#else
-                    printf("WiFi connected! IP: %s\n", ip.c_str());
-#endif
-                    break;
-                }
+        hw.connectWiFi(config.wifi.ssid, config.wifi.password);
+        
+        // 接続結果を待つ（最大5秒）
+        for (int cnt = 0; cnt < 50; cnt++) {
+            hw.update();
+            if (hw.getWiFiStatus() == WiFiStatus::CONNECTED) {
+                char ip[IP_ADDRESS_SIZE];
+                hw.getIPAddress(ip, sizeof(ip));
+                APP_LOGI("WiFi connected! IP: %s", ip);
+                break;
+            }
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
-                delay(100);
+            delay(100);
 #else
-                // エミュレーターでは即座に接続成功
-                break;
+            // エミュレーターでは即座に接続成功
+            break;
 #endif
-            }
         }
         
         // スタート画面から開始
         if (lvgl_port_lock()) {
-            create_screen_start();
-            current_screen = SCREEN_START;
+            screen_transition(SCREEN_START, "setup");
             lvgl_port_unlock();
         }
     } else {
         // WiFi設定がない場合、WiFi設定画面を表示
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-        Serial.println("No WiFi config found - showing WiFi setup screen");
-#else
-        printf("No WiFi config found - showing WiFi setup screen\n");
-#endif
+        APP_LOGI("No WiFi config found - showing WiFi setup screen");
         
         if (lvgl_port_lock()) {
-            create_screen_wifi_setup();
-            current_screen = SCREEN_WIFI_SETUP;
+            screen_transition(SCREEN_WIFI_SETUP, "no wifi config");
             lvgl_port_unlock();
         }
     }
+
+    // 計測・ネットワークのタスクを開始（APP_TASK_PLAN のコア・優先度）
+    sensor_task.threaded = app_task_start(APP_TASK_SENSOR, scheduler_task, &sensor_task);
+    net_task.threaded    = app_task_start(APP_TASK_NET, scheduler_task, &net_task);
 }
 
 ///////////////////////////////////////
 /// @brief ユーザーアプリケーションのメインループ
-/// 画面状態に応じた処理
-void user_app_loop(void)
+/// 期限を過ぎた周期ジョブを実行する（タスクを作れない環境では計測・ネットワークのジョブとログの出力も）
+/// @return 次の期限までの時間 [ms]（呼び出し側はこの時間だけ待つ）
+uint32_t user_app_loop(void)
 {
-    // ハードウェア更新
-    HardwareInterface* hw = getHardware();
-    hw->update();
-    
-    // 画面状態に応じた処理
-    switch (current_screen) {
-        case SCREEN_WIFI_SETUP:
-            // WiFi設定画面：Webサーバー処理（LVGLロック不要）
-            update_wifi_setup();
-            break;
-            
-        case SCREEN_START:
-            // スタート画面：Aボタンでメイン画面へ遷移
-            if (lvgl_port_lock()) {
-                update_screen_start();
-                lvgl_port_unlock();
-            }
-            break;
-            
-        case SCREEN_MAIN:
-            // メイン画面：重量計表示の更新
-            if (lvgl_port_lock()) {
-                update_screen_main();
-                lvgl_port_unlock();
-            }
-            break;
+    uint32_t wait_ms = scheduler.runDue(lv_tick_get(), LOOP_MAX_WAIT_MS);
+    app_task_add_busy(APP_TASK_APP, scheduler.takeBusyUs());
 
-        case SCREEN_VERSION:
-            // バージョン画面：Aボタン短押しでキャリブレーション画面、Bボタン短押しでメイン画面
-            if (lvgl_port_lock()) {
-                update_screen_version();
-                lvgl_port_unlock();
-            }
-            break;
-
-        case SCREEN_CALIBRATION:
-            if (lvgl_port_lock()) {
-                update_screen_calibration();
-                lvgl_port_unlock();
-            }
-            break;
-            
-        default:
-            // 未定義の画面状態（エラー処理）
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-            Serial.printf("Unknown screen state: %d\n", current_screen);
-#else
-            printf("Unknown screen state: %d\n", current_screen);
-#endif
-            break;
+    SchedulerTask* inline_tasks[] = {&sensor_task, &net_task};
+    for (SchedulerTask* task : inline_tasks) {
+        if (task->threaded) {
+            continue;
+        }
+        uint32_t task_wait_ms = task->scheduler.runDue(lv_tick_get(), LOOP_MAX_WAIT_MS);
+        app_task_add_busy(task->id, task->scheduler.takeBusyUs());
+        if (task_wait_ms < wait_ms) {
+            wait_ms = task_wait_ms;
+        }
+    }
+    if (!log_threaded) {
+        uint32_t start_us = app_clock_micros();
+        app_log_drain();
+        app_task_add_busy(APP_TASK_LOG, app_clock_micros() - start_us);
     }
-}
\ No newline at end of file
+    return wait_ms;
+}
+
+///////////////////////////////////////
+/// @brief 周期ジョブとタスクの負荷の統計を出力
+void user_app_print_stats(void)
+{
+    app_log_drain();  // 統計より前のログを先に出力
+    scheduler.printStats();
+    sensor_task.scheduler.printStats();
+    net_task.scheduler.printStats();
+    app_task_print_load();
+    heap_audit_print();
+    BoundLabelBase::printStats();
+    config_store.printStats();
+}
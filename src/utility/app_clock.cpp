@@ -0,0 +1,62 @@
+#include "app_clock.hpp"
+
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
+
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+#elif defined(EMULATOR_HEADLESS)
+// 仮想時計（外部からの待機要求でのみ進む）
+static uint32_t virtual_now_ms = 0;
+#elif __has_include(<SDL2/SDL.h>)
+#include <SDL2/SDL.h>
+#elif __has_include(<SDL.h>)
+#include <SDL.h>
+#endif
+
+uint32_t app_clock_millis(void)
+{
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+    return millis();
+#elif defined(EMULATOR_HEADLESS)
+    return virtual_now_ms;
+#elif __has_include(<SDL2/SDL.h>) || __has_include(<SDL.h>)
+    return SDL_GetTicks();
+#else
+    return 0;
+#endif
+}
+
+uint32_t app_clock_micros(void)
+{
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+    return micros();
+#else
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+#endif
+}
+
+void app_clock_sleep_ms(uint32_t ms)
+{
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+    delay(ms);
+#elif defined(EMULATOR_HEADLESS)
+    virtual_now_ms += ms;
+#elif __has_include(<SDL2/SDL.h>) || __has_include(<SDL.h>)
+    SDL_Delay(ms);
+#else
+    (void)ms;
+#endif
+}
+
+bool app_clock_is_virtual(void)
+{
+#if defined(EMULATOR_HEADLESS)
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,34 @@
+#ifndef __APP_CLOCK_HPP__
+#define __APP_CLOCK_HPP__
+
+#include <stdint.h>
+
+/**
+ * @brief アプリケーション共通の時計
+ * 実機では millis()、SDLエミュレーターでは SDL_GetTicks() を使用する。
+ * ヘッドレスエミュレーター（EMULATOR_HEADLESS）では仮想時計となり、
+ * app_clock_sleep_ms() で待つ代わりに時刻を進めるため実時間より高速に動作する。
+ */
+
+/**
+ * @brief 現在時刻 [ms]
+ */
+uint32_t app_clock_millis(void);
+
+/**
+ * @brief 処理時間の計測用タイマー [us]
+ * 仮想時計でも実時間を返す（32bitで約71分で一周、差分で使うこと）
+ */
+uint32_t app_clock_micros(void);
+
+/**
+ * @brief 指定時間待機（仮想時計では時刻を進めるだけ）
+ */
+void app_clock_sleep_ms(uint32_t ms);
+
+/**
+ * @brief 仮想時計で動作しているか
+ */
+bool app_clock_is_virtual(void);
+
+#endif  // __APP_CLOCK_HPP__
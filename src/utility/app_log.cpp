@@ -0,0 +1,288 @@
+#include "app_log.hpp"
+
+#include <stdio.h>
+
+#include <atomic>
+
+#include "app_clock.hpp"
+#include "app_tasks.hpp"
+
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+#include <Arduino.h>
+#endif
+
+static_assert(0 == (APP_LOG_SLOTS & (APP_LOG_SLOTS - 1)), "APP_LOG_SLOTS must be a power of 2");
+
+static const uint32_t APP_LOG_DRAIN_MS = 20;   // ログタスクの出力周期 [ms]
+static const size_t APP_LOG_LINE_MAX   = 192;  // テキスト1行の上限（超えた分は切り捨て）
+
+// バイナリのフレーム（リトルエンディアン）
+//   0xA5, 長さ(以降のバイト数), 書式文字列のアドレス(4), 時刻ms(4), レベル(1), 引数の数(1), 型(引数の数), 値(残り)
+// フレーム以外のバイト（起動時のROMの出力やログを経由しない Serial 出力）はそのまま流れる
+static const uint8_t APP_LOG_FRAME_SYNC  = 0xA5;
+static const size_t APP_LOG_FRAME_HEADER = 2 + 4 + 4 + 1 + 1;
+static const size_t APP_LOG_FRAME_MAX    = APP_LOG_FRAME_HEADER + APP_LOG_MAX_ARGS + APP_LOG_PAYLOAD_SIZE;
+
+// 有界MPMCキュー（各レコードの sequence で空き・書き込み済みを判定し、位置はCASで確保）
+// sequence はレコードの番号を引いた値で持つ（ゼロ初期化のまま使えるように）
+struct LogSlot {
+    std::atomic<uint32_t> sequence;
+    AppLogRecord record;
+};
+static LogSlot log_slots[APP_LOG_SLOTS];
+static std::atomic<uint32_t> log_head(0);     // 次に積む位置
+static std::atomic<uint32_t> log_tail(0);     // 次に取り出す位置
+static std::atomic<uint32_t> log_dropped(0);  // 満杯で捨てた件数（起動から）
+static std::atomic<uint32_t> log_unreported(0);
+
+static void copy_record(AppLogRecord* dst, const AppLogRecord& src)
+{
+    // 引数の領域は使った分だけコピーする
+    memcpy(dst, &src, offsetof(AppLogRecord, payload) + src.size);
+}
+
+void app_log_push(AppLogRecord& record)
+{
+    record.time_ms = app_clock_millis();
+
+    uint32_t pos = log_head.load(std::memory_order_relaxed);
+    while (true) {
+        uint32_t index = pos & (APP_LOG_SLOTS - 1);
+        LogSlot& slot  = log_slots[index];
+        int32_t diff   = (int32_t)(slot.sequence.load(std::memory_order_acquire) + index - pos);
+        if (0 == diff) {
+            if (log_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                copy_record(&slot.record, record);
+                slot.sequence.store(pos + 1 - index, std::memory_order_release);
+                return;
+            }
+        } else if (diff < 0) {
+            // 満杯（ログタスクが追いついていない）
+            log_dropped.fetch_add(1, std::memory_order_relaxed);
+            log_unreported.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = log_head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool app_log_pop(AppLogRecord* record)
+{
+    uint32_t pos = log_tail.load(std::memory_order_relaxed);
+    while (true) {
+        uint32_t index = pos & (APP_LOG_SLOTS - 1);
+        LogSlot& slot  = log_slots[index];
+        int32_t diff   = (int32_t)(slot.sequence.load(std::memory_order_acquire) + index - (pos + 1));
+        if (0 == diff) {
+            if (log_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                copy_record(record, slot.record);
+                slot.sequence.store(pos + APP_LOG_SLOTS - index, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = log_tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+///////////////////////////////////////
+/// @brief 整形先への追記（あふれたら切り詰める）
+static void append(size_t size, size_t* pos, int written)
+{
+    if (0 < written) {
+        *pos += (size_t)written;
+    }
+    if (size <= *pos) {
+        *pos = size - 1;
+    }
+}
+
+size_t app_log_format(const AppLogRecord& record, char* buf, size_t size)
+{
+    static const char LEVELS[] = "NEWID";
+
+    if (0 == size) {
+        return 0;
+    }
+    size_t pos = 0;
+    append(size, &pos,
+           snprintf(buf, size, "%c (%lu) ", LEVELS[record.level <= APP_LOG_LEVEL_DEBUG ? record.level : 0],
+                    (unsigned long)record.time_ms));
+
+    const uint8_t* value = record.payload;
+    uint8_t arg          = 0;
+    const char* p        = record.fmt;
+    while ('\0' != *p && pos < size - 1) {
+        if ('%' != *p) {
+            buf[pos++] = *p++;
+            continue;
+        }
+        if ('%' == p[1]) {
+            buf[pos++] = '%';
+            p += 2;
+            continue;
+        }
+
+        // 変換指定を1つ切り出し、長さ修飾子は積んだ型に合わせて付け直す
+        char spec[24];
+        size_t n = 0;
+        spec[n++] = *p++;
+        while ('\0' != *p && (nullptr != strchr("-+ #0123456789.", *p)) && n < sizeof(spec) - 4) {
+            spec[n++] = *p++;
+        }
+        while ('\0' != *p && nullptr != strchr("hlLqjzt", *p)) {
+            p++;
+        }
+        char conv = *p;
+        if ('\0' != conv) {
+            p++;
+        }
+
+        uint8_t type = (arg < record.nargs) ? record.types[arg] : (uint8_t)APP_LOG_ARG_NONE;
+        arg++;
+        bool is_string = ('s' == conv);
+        bool is_float  = ('\0' != conv && nullptr != strchr("fFeEgGaA", conv));
+        bool is_int    = ('\0' != conv && nullptr != strchr("diouxXc", conv));
+        char* out      = buf + pos;
+        size_t room    = size - pos;
+        int written    = 0;
+        if (APP_LOG_ARG_STR == type) {
+            uint8_t length = value[0];
+            char text[APP_LOG_PAYLOAD_SIZE];
+            memcpy(text, value + 1, length);
+            text[length] = '\0';
+            value += 1 + length;
+            spec[n++] = 's';
+            spec[n]   = '\0';
+            written   = is_string ? snprintf(out, room, spec, text) : snprintf(out, room, "?");
+        } else if (APP_LOG_ARG_F64 == type) {
+            double v;
+            memcpy(&v, value, sizeof(v));
+            value += sizeof(v);
+            spec[n++] = conv;
+            spec[n]   = '\0';
+            written   = is_float ? snprintf(out, room, spec, v) : snprintf(out, room, "?");
+        } else if (APP_LOG_ARG_I32 == type || APP_LOG_ARG_U32 == type) {
+            uint32_t v;
+            memcpy(&v, value, sizeof(v));
+            value += sizeof(v);
+            spec[n++] = conv;
+            spec[n]   = '\0';
+            if (!is_int) {
+                written = snprintf(out, room, "?");
+            } else if (APP_LOG_ARG_I32 == type) {
+                written = snprintf(out, room, spec, (int)(int32_t)v);
+            } else {
+                written = snprintf(out, room, spec, (unsigned)v);
+            }
+        } else if (APP_LOG_ARG_I64 == type || APP_LOG_ARG_U64 == type) {
+            uint64_t v;
+            memcpy(&v, value, sizeof(v));
+            value += sizeof(v);
+            spec[n++] = 'l';
+            spec[n++] = 'l';
+            spec[n++] = conv;
+            spec[n]   = '\0';
+            if (!is_int || 'c' == conv) {
+                written = snprintf(out, room, "?");
+            } else if (APP_LOG_ARG_I64 == type) {
+                written = snprintf(out, room, spec, (long long)(int64_t)v);
+            } else {
+                written = snprintf(out, room, spec, (unsigned long long)v);
+            }
+        } else {
+            written = snprintf(out, room, "?");
+        }
+        append(size, &pos, written);
+    }
+
+    if (pos < size - 1) {
+        buf[pos++] = '\n';
+    }
+    buf[pos] = '\0';
+    return pos;
+}
+
+static void put_u32(uint8_t* dst, uint32_t value)
+{
+    dst[0] = (uint8_t)value;
+    dst[1] = (uint8_t)(value >> 8);
+    dst[2] = (uint8_t)(value >> 16);
+    dst[3] = (uint8_t)(value >> 24);
+}
+
+size_t app_log_encode(const AppLogRecord& record, uint8_t* buf, size_t size)
+{
+    size_t length = APP_LOG_FRAME_HEADER + record.nargs + record.size;
+    if (size < length) {
+        return 0;
+    }
+    buf[0] = APP_LOG_FRAME_SYNC;
+    buf[1] = (uint8_t)(length - 2);
+    put_u32(buf + 2, (uint32_t)(uintptr_t)record.fmt);
+    put_u32(buf + 6, record.time_ms);
+    buf[10] = record.level;
+    buf[11] = record.nargs;
+    memcpy(buf + APP_LOG_FRAME_HEADER, record.types, record.nargs);
+    memcpy(buf + APP_LOG_FRAME_HEADER + record.nargs, record.payload, record.size);
+    return length;
+}
+
+///////////////////////////////////////
+/// @brief 1件を出力（ログタスクから呼ぶ、UARTの送信待ちはここで発生する）
+static void output_record(const AppLogRecord& record)
+{
+#if APP_LOG_BINARY
+    uint8_t frame[APP_LOG_FRAME_MAX];
+    size_t length = app_log_encode(record, frame, sizeof(frame));
+#else
+    char frame[APP_LOG_LINE_MAX];
+    size_t length = app_log_format(record, frame, sizeof(frame));
+#endif
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+    Serial.write((const uint8_t*)frame, length);
+#else
+    fwrite(frame, 1, length, stdout);
+#endif
+}
+
+uint32_t app_log_drain(void)
+{
+    uint32_t count = 0;
+    AppLogRecord record;
+    while (app_log_pop(&record)) {
+        output_record(record);
+        count++;
+    }
+
+    uint32_t lost = log_unreported.exchange(0, std::memory_order_relaxed);
+    if (0 < lost) {
+        record.fmt     = "log: %lu messages dropped";
+        record.time_ms = app_clock_millis();
+        record.level   = APP_LOG_LEVEL_WARN;
+        record.nargs   = 0;
+        record.size    = 0;
+        app_log_pack(&record, (unsigned long)lost);
+        output_record(record);
+    }
+    return count;
+}
+
+void app_log_task(void* arg)
+{
+    (void)arg;
+    while (1) {
+        uint32_t start_us = app_clock_micros();
+        app_log_drain();
+        app_task_add_busy(APP_TASK_LOG, app_clock_micros() - start_us);
+        app_clock_sleep_ms(APP_LOG_DRAIN_MS);
+    }
+}
+
+uint32_t app_log_get_dropped(void)
+{
+    return log_dropped.load(std::memory_order_relaxed);
+}
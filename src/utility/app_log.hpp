@@ -0,0 +1,223 @@
+#ifndef __APP_LOG_HPP__
+#define __APP_LOG_HPP__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <type_traits>
+
+/**
+ * @brief 遅延ログ
+ * 呼び出し側は書式文字列のアドレス（ID）と引数の生の値をリングに積むだけで、整形とUART/標準出力への
+ * 書き込みは優先度の低いログタスク（APP_TASK_LOG）が行う。リングはロックなしで、満杯なら捨てて数える。
+ *   APP_LOGI("WiFi connected! IP: %s", ip);   // 改行は付けない
+ * 文字列引数は積む時点でコピーするため、スタック上のバッファを渡してよい。
+ * 出力は "I (時刻ms) メッセージ"。APP_LOG_BINARY=1 ではバイナリのまま出力し、
+ * ホスト側で support/log_decode.py がファームウェアのELFから書式文字列を引いて復元する。
+ */
+
+// ログレベル（APP_LOG_LEVEL より詳細なレベルはコンパイル時に消える、引数も評価しない）
+#define APP_LOG_LEVEL_NONE  0
+#define APP_LOG_LEVEL_ERROR 1
+#define APP_LOG_LEVEL_WARN  2
+#define APP_LOG_LEVEL_INFO  3
+#define APP_LOG_LEVEL_DEBUG 4
+
+#ifndef APP_LOG_LEVEL
+#define APP_LOG_LEVEL APP_LOG_LEVEL_INFO
+#endif
+
+// 0: ログタスクで整形してテキストで出力、1: バイナリのフレームで出力（support/log_decode.py で復元）
+#ifndef APP_LOG_BINARY
+#define APP_LOG_BINARY 0
+#endif
+
+// リングのレコード数（2のべき乗）
+#ifndef APP_LOG_SLOTS
+#define APP_LOG_SLOTS 64
+#endif
+
+static const uint8_t APP_LOG_MAX_ARGS     = 6;   // 1件あたりの引数の上限
+static const uint8_t APP_LOG_PAYLOAD_SIZE = 56;  // 引数の値（文字列は長さ+本文）の領域 [bytes]
+
+/**
+ * @brief 引数の型（リング・バイナリ出力での表現）
+ */
+enum AppLogArg : uint8_t {
+    APP_LOG_ARG_I32,  // int32_t
+    APP_LOG_ARG_U32,  // uint32_t
+    APP_LOG_ARG_I64,  // int64_t
+    APP_LOG_ARG_U64,  // uint64_t
+    APP_LOG_ARG_F64,  // double（float も double で積む）
+    APP_LOG_ARG_STR,  // 長さ(1byte) + 本文（領域に収まる分だけ）
+    APP_LOG_ARG_NONE  // 領域に収まらなかった（"?" と出力）
+};
+
+/**
+ * @brief ログ1件
+ */
+struct AppLogRecord {
+    const char* fmt;  // 書式文字列（静的な文字列リテラル、アドレスがID）
+    uint32_t time_ms;
+    uint8_t level;
+    uint8_t nargs;
+    uint8_t size;  // payload の使用量
+    uint8_t types[APP_LOG_MAX_ARGS];
+    uint8_t payload[APP_LOG_PAYLOAD_SIZE];
+};
+
+///////////////////////////////////////
+/// @brief 引数を1つ積む
+inline void app_log_pack_raw(AppLogRecord* record, AppLogArg type, const void* value, uint8_t size)
+{
+    if (APP_LOG_MAX_ARGS <= record->nargs) {
+        return;
+    }
+    if (APP_LOG_PAYLOAD_SIZE - record->size < size) {
+        type = APP_LOG_ARG_NONE;
+        size = 0;
+    }
+    memcpy(record->payload + record->size, value, size);
+    record->types[record->nargs++] = type;
+    record->size                   = (uint8_t)(record->size + size);
+}
+
+inline void app_log_pack_arg(AppLogRecord* record, const char* value)
+{
+    if (APP_LOG_MAX_ARGS <= record->nargs) {
+        return;
+    }
+    if (nullptr == value) {
+        value = "(null)";
+    }
+    // 長さの1byteを除いた残りに収まる分だけコピー（収まらない部分は切り捨て）
+    size_t room = (record->size < APP_LOG_PAYLOAD_SIZE) ? APP_LOG_PAYLOAD_SIZE - record->size - 1 : 0;
+    if (0 == room) {
+        app_log_pack_raw(record, APP_LOG_ARG_NONE, nullptr, 0);
+        return;
+    }
+    uint8_t* dst   = record->payload + record->size;
+    uint8_t length = 0;
+    while (length < room && '\0' != value[length]) {
+        dst[1 + length] = (uint8_t)value[length];
+        length++;
+    }
+    dst[0]                         = length;
+    record->types[record->nargs++] = APP_LOG_ARG_STR;
+    record->size                   = (uint8_t)(record->size + 1 + length);
+}
+
+inline void app_log_pack_arg(AppLogRecord* record, char* value)
+{
+    app_log_pack_arg(record, (const char*)value);
+}
+
+template <typename T>
+inline void app_log_pack_arg(AppLogRecord* record, T value)
+{
+    static_assert(std::is_arithmetic<T>::value, "APP_LOG: unsupported argument type (cast enums to int)");
+    if (std::is_floating_point<T>::value) {
+        double v = (double)value;
+        app_log_pack_raw(record, APP_LOG_ARG_F64, &v, sizeof(v));
+    } else if (sizeof(T) <= 4 && std::is_signed<T>::value) {
+        int32_t v = (int32_t)value;
+        app_log_pack_raw(record, APP_LOG_ARG_I32, &v, sizeof(v));
+    } else if (sizeof(T) <= 4) {
+        uint32_t v = (uint32_t)value;
+        app_log_pack_raw(record, APP_LOG_ARG_U32, &v, sizeof(v));
+    } else if (std::is_signed<T>::value) {
+        int64_t v = (int64_t)value;
+        app_log_pack_raw(record, APP_LOG_ARG_I64, &v, sizeof(v));
+    } else {
+        uint64_t v = (uint64_t)value;
+        app_log_pack_raw(record, APP_LOG_ARG_U64, &v, sizeof(v));
+    }
+}
+
+inline void app_log_pack(AppLogRecord*)
+{
+}
+
+template <typename T, typename... Rest>
+inline void app_log_pack(AppLogRecord* record, T first, Rest... rest)
+{
+    app_log_pack_arg(record, first);
+    app_log_pack(record, rest...);
+}
+
+/**
+ * @brief リングに積む（満杯なら捨てて数える、待たない）
+ */
+void app_log_push(AppLogRecord& record);
+
+/**
+ * @brief リングから1件取り出す（ログタスク・ベンチマーク用）
+ * @return 空なら false
+ */
+bool app_log_pop(AppLogRecord* record);
+
+template <typename... Args>
+inline void app_log_write(uint8_t level, const char* fmt, Args... args)
+{
+    AppLogRecord record;
+    record.fmt   = fmt;
+    record.level = level;
+    record.nargs = 0;
+    record.size  = 0;
+    app_log_pack(&record, args...);
+    app_log_push(record);
+}
+
+/**
+ * @brief 書式と引数の型の検査用（呼び出されない）
+ */
+inline void app_log_check_format(const char*, ...) __attribute__((format(printf, 1, 2)));
+inline void app_log_check_format(const char*, ...)
+{
+}
+
+#define APP_LOG(level, fmt, ...)                                 \
+    do {                                                         \
+        if ((level) <= APP_LOG_LEVEL) {                          \
+            if (false) {                                         \
+                app_log_check_format(fmt, ##__VA_ARGS__);        \
+            }                                                    \
+            app_log_write((uint8_t)(level), fmt, ##__VA_ARGS__); \
+        }                                                        \
+    } while (0)
+
+#define APP_LOGE(fmt, ...) APP_LOG(APP_LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#define APP_LOGW(fmt, ...) APP_LOG(APP_LOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#define APP_LOGI(fmt, ...) APP_LOG(APP_LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#define APP_LOGD(fmt, ...) APP_LOG(APP_LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+
+/**
+ * @brief 1件をテキストに整形（"I (時刻ms) メッセージ\n"）
+ * @return 書き込んだ長さ（size-1 で切り詰め）
+ */
+size_t app_log_format(const AppLogRecord& record, char* buf, size_t size);
+
+/**
+ * @brief 1件をバイナリのフレームに変換（形式は app_log.cpp、復号は support/log_decode.py）
+ * @return フレームの長さ
+ */
+size_t app_log_encode(const AppLogRecord& record, uint8_t* buf, size_t size);
+
+/**
+ * @brief リングの内容をすべて出力（ログタスク・終了前・再起動前に呼ぶ）
+ * @return 出力した件数
+ */
+uint32_t app_log_drain(void);
+
+/**
+ * @brief ログタスク（app_task_start(APP_TASK_LOG, app_log_task, nullptr) で開始）
+ */
+void app_log_task(void* arg);
+
+/**
+ * @brief 満杯で捨てた件数（起動から）
+ */
+uint32_t app_log_get_dropped(void);
+
+#endif  // __APP_LOG_HPP__
@@ -0,0 +1,99 @@
+#include "app_scheduler.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "app_clock.hpp"
+
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+#include <Arduino.h>
+#endif
+
+AppScheduler::AppScheduler() : count(0), busy_us(0)
+{
+    memset(jobs, 0, sizeof(jobs));
+}
+
+int AppScheduler::add(const char* name, JobFunc func, uint32_t period_ms, uint32_t now_ms)
+{
+    if (MAX_JOBS <= count || nullptr == func) {
+        return -1;
+    }
+    Job& job      = jobs[count];
+    job.name      = name;
+    job.func      = func;
+    job.period_ms = period_ms;
+    job.next_ms   = now_ms;  // 最初の runDue() で実行
+    memset(&job.stats, 0, sizeof(job.stats));
+    return count++;
+}
+
+void AppScheduler::setPeriod(int job, uint32_t period_ms, uint32_t now_ms, bool run_now)
+{
+    if (job < 0 || count <= job) {
+        return;
+    }
+    jobs[job].period_ms = period_ms;
+    jobs[job].next_ms   = run_now ? now_ms : now_ms + period_ms;
+}
+
+uint32_t AppScheduler::runDue(uint32_t now_ms, uint32_t max_wait_ms)
+{
+    for (uint8_t i = 0; i < count; i++) {
+        Job& job = jobs[i];
+        if (0 == job.period_ms || (int32_t)(now_ms - job.next_ms) < 0) {
+            continue;
+        }
+
+        // 期限からの遅れ：1周期以上なら逃した周期を飛ばす（位相は保つ）
+        uint32_t late   = now_ms - job.next_ms;
+        uint32_t missed = late / job.period_ms;
+        job.next_ms += (missed + 1) * job.period_ms;
+        job.stats.overruns += missed;
+        if (job.stats.late_max < late) {
+            job.stats.late_max = late;
+        }
+
+        uint32_t start_us = app_clock_micros();
+        job.func();
+        uint32_t run_us = app_clock_micros() - start_us;
+        busy_us += run_us;
+        job.stats.runs++;
+        if (job.stats.run_us_max < run_us) {
+            job.stats.run_us_max = run_us;
+        }
+    }
+
+    // 次の期限までの時間（ジョブ内で周期が変わった場合も反映される）
+    uint32_t wait = max_wait_ms;
+    for (uint8_t i = 0; i < count; i++) {
+        const Job& job = jobs[i];
+        if (0 == job.period_ms) {
+            continue;
+        }
+        int32_t until = (int32_t)(job.next_ms - now_ms);
+        if (until <= 0) {
+            return 0;
+        }
+        if ((uint32_t)until < wait) {
+            wait = (uint32_t)until;
+        }
+    }
+    return wait;
+}
+
+void AppScheduler::printStats(void) const
+{
+    for (uint8_t i = 0; i < count; i++) {
+        const Job& job = jobs[i];
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+        Serial.printf("Job %-8s %5lu ms: %lu runs, %lu overruns, late max %lu ms, run max %lu us\n", job.name,
+                      (unsigned long)job.period_ms, (unsigned long)job.stats.runs, (unsigned long)job.stats.overruns,
+                      (unsigned long)job.stats.late_max, (unsigned long)job.stats.run_us_max);
+#else
+        printf("Job %-8s %5lu ms: %lu runs, %lu overruns, late max %lu ms, run max %lu us\n", job.name,
+               (unsigned long)job.period_ms, (unsigned long)job.stats.runs, (unsigned long)job.stats.overruns,
+               (unsigned long)job.stats.late_max, (unsigned long)job.stats.run_us_max);
+#endif
+    }
+}
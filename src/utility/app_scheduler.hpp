@@ -0,0 +1,79 @@
+#ifndef __APP_SCHEDULER_HPP__
+#define __APP_SCHEDULER_HPP__
+
+#include <stdint.h>
+
+/**
+ * @brief 周期ジョブの協調スケジューラー
+ * ジョブごとの周期と次の期限を持ち、runDue() で期限を過ぎたジョブを登録順に実行して
+ * 次の期限までの時間を返す。呼び出し側はその時間だけ待てばよい（実機は delay()、
+ * エミュレーターは SDL_Delay()、ヘッドレスは仮想時計を進める）。
+ * 実行が遅れて1周期以上の期限を逃した場合は取りこぼしとして数え、位相を保ったまま次の期限へ進める
+ * （遅れを取り戻すための連続実行はしない）。
+ */
+class AppScheduler {
+public:
+    static const uint8_t MAX_JOBS = 8;
+
+    typedef void (*JobFunc)(void);
+
+    struct JobStats {
+        uint32_t runs;        // 実行回数
+        uint32_t overruns;    // 取りこぼした周期の数
+        uint32_t late_max;    // 期限からの最大遅れ [ms]
+        uint32_t run_us_max;  // 最大実行時間 [us]
+    };
+
+    AppScheduler();
+
+    /**
+     * @brief ジョブを登録
+     * @param period_ms 周期 [ms]（0=停止）
+     * @return ジョブ番号（登録できなければ -1）
+     */
+    int add(const char* name, JobFunc func, uint32_t period_ms, uint32_t now_ms);
+
+    /**
+     * @brief 周期を変更（次の期限は now_ms から数え直す、0=停止）
+     * @param run_now true なら次の runDue() で実行する
+     */
+    void setPeriod(int job, uint32_t period_ms, uint32_t now_ms, bool run_now);
+
+    /**
+     * @brief 期限を過ぎたジョブを実行
+     * @return 次の期限までの時間 [ms]（実行中のジョブがなければ max_wait_ms）
+     */
+    uint32_t runDue(uint32_t now_ms, uint32_t max_wait_ms);
+
+    /**
+     * @brief 前回の呼び出し以降のジョブ実行時間の合計 [us]（タスクのCPU負荷の計測用）
+     */
+    uint32_t takeBusyUs(void)
+    {
+        uint32_t us = busy_us;
+        busy_us     = 0;
+        return us;
+    }
+
+    const JobStats& getStats(int job) const
+    {
+        return jobs[job].stats;
+    }
+
+    void printStats(void) const;
+
+private:
+    struct Job {
+        const char* name;
+        JobFunc func;
+        uint32_t period_ms;
+        uint32_t next_ms;  // 次の期限
+        JobStats stats;
+    };
+
+    Job jobs[MAX_JOBS];
+    uint8_t count;
+    uint32_t busy_us;
+};
+
+#endif  // __APP_SCHEDULER_HPP__
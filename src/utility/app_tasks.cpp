@@ -0,0 +1,95 @@
+#include "app_tasks.hpp"
+
+#include <atomic>
+#include <stdio.h>
+
+#include "app_clock.hpp"
+
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+#include <Arduino.h>
+#elif !defined(EMULATOR_HEADLESS)
+#include <thread>
+#endif
+
+// Arduinoの loopTask はコア1（ARDUINO_RUNNING_CORE）で生成済みのため、app は優先度のみ反映される
+const AppTaskDef APP_TASK_PLAN[APP_TASK_COUNT] = {
+    {"sensor", 1, 4, 3072},  // HX711の読み出し（変換待ちは vTaskDelay で譲り、その間は下位が動く）
+    {"lvgl", 1, 3, 4096},    // 描画
+    {"app", 1, 2, 8192},     // ボタン・画面
+    {"net", 0, 1, 6144},     // WebサーバーはWiFi/TCPスタックと同じコア
+    {"log", -1, 1, 3072},    // ログの整形・出力（空いているコアで）
+};
+
+static std::atomic<uint32_t> busy_us[APP_TASK_COUNT];
+static uint32_t window_start_us = 0;
+
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+static TaskHandle_t task_handles[APP_TASK_COUNT];
+#endif
+
+static void start_window(void)
+{
+    if (0 == window_start_us) {
+        window_start_us = app_clock_micros();
+    }
+}
+
+bool app_task_start(AppTaskId id, AppTaskFunc func, void* arg)
+{
+    const AppTaskDef& plan = APP_TASK_PLAN[id];
+    start_window();
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+    BaseType_t core = (plan.core < 0) ? tskNO_AFFINITY : plan.core;
+    return pdPASS == xTaskCreatePinnedToCore(func, plan.name, plan.stack_bytes, arg, plan.priority,
+                                             &task_handles[id], core);
+#elif defined(EMULATOR_HEADLESS)
+    (void)plan;
+    (void)func;
+    (void)arg;
+    return false;
+#else
+    (void)plan;
+    std::thread(func, arg).detach();
+    return true;
+#endif
+}
+
+void app_task_adopt(AppTaskId id)
+{
+    start_window();
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+    task_handles[id] = xTaskGetCurrentTaskHandle();
+    vTaskPrioritySet(NULL, APP_TASK_PLAN[id].priority);
+#else
+    (void)id;
+#endif
+}
+
+void app_task_add_busy(AppTaskId id, uint32_t us)
+{
+    busy_us[id].fetch_add(us, std::memory_order_relaxed);
+}
+
+void app_task_print_load(void)
+{
+    uint32_t now_us     = app_clock_micros();
+    uint32_t elapsed_us = now_us - window_start_us;
+    window_start_us     = now_us;
+    if (0 == elapsed_us) {
+        return;
+    }
+
+    for (int id = 0; id < APP_TASK_COUNT; id++) {
+        const AppTaskDef& plan = APP_TASK_PLAN[id];
+        uint32_t busy          = busy_us[id].exchange(0, std::memory_order_relaxed);
+        unsigned load_x10      = (unsigned)((uint64_t)busy * 1000 / elapsed_us);
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+        unsigned stack_free = task_handles[id] ? (unsigned)uxTaskGetStackHighWaterMark(task_handles[id]) : 0;
+        Serial.printf("Task %-6s core %d prio %u: %3u.%u%% CPU, stack free %u B\n", plan.name, plan.core,
+                      plan.priority, load_x10 / 10, load_x10 % 10, stack_free);
+#else
+        printf("Task %-6s core %d prio %u: %3u.%u%% CPU\n", plan.name, plan.core, plan.priority, load_x10 / 10,
+               load_x10 % 10);
+#endif
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef __APP_TASKS_HPP__
+#define __APP_TASKS_HPP__
+
+#include <stdint.h>
+
+/**
+ * @brief アプリのタスク（スレッド）
+ */
+enum AppTaskId {
+    APP_TASK_SENSOR,  // 重量センサーの取得
+    APP_TASK_LVGL,    // LVGLの描画（lvgl_port）
+    APP_TASK_APP,     // ボタン・画面（Arduinoの loop()）
+    APP_TASK_NET,     // WiFi設定Webサーバー
+    APP_TASK_LOG,     // ログの出力（app_log）
+    APP_TASK_COUNT
+};
+
+/**
+ * @brief タスクの配置
+ */
+struct AppTaskDef {
+    const char* name;
+    int8_t core;           // 固定するコア（-1=固定しない）
+    uint8_t priority;      // FreeRTOSの優先度（大きいほど優先）
+    uint32_t stack_bytes;  // スタックサイズ
+};
+
+/**
+ * @brief タスクの配置計画
+ * 実機（ESP32デュアルコア）では各タスクを FreeRTOS タスクとして指定のコアに固定する。
+ * コア0はWiFi/TCPスタックが動くため、ネットワーク処理を同じコアに置く。
+ * コア1には計測・描画・アプリを置き、計測 > 描画 > アプリの優先度で分ける。
+ * ログの出力（UARTの送信待ち）は最も低い優先度で空いているコアに任せる。
+ * SDLエミュレーターでは std::thread に対応付ける（コア・優先度は使わない）。
+ * ヘッドレスでは仮想時計を決定的に進めるため、タスクを作らずメインループから順に実行する。
+ */
+extern const AppTaskDef APP_TASK_PLAN[APP_TASK_COUNT];
+
+typedef void (*AppTaskFunc)(void* arg);
+
+/**
+ * @brief 計画どおりにタスクを生成
+ * @param func 戻らない関数
+ * @return 生成できなかった場合（ヘッドレスでは常に）false、呼び出し側がメインループから実行する
+ */
+bool app_task_start(AppTaskId id, AppTaskFunc func, void* arg);
+
+/**
+ * @brief 呼び出し元を計画のタスクとして登録（優先度を計画に合わせる）
+ * Arduinoの loopTask など、app_task_start() 以外で作られたタスク用
+ */
+void app_task_adopt(AppTaskId id);
+
+/**
+ * @brief タスクの実行時間を加算（待機を除いた処理時間）
+ */
+void app_task_add_busy(AppTaskId id, uint32_t busy_us);
+
+/**
+ * @brief タスクごとのCPU負荷を出力し、計測期間をリセット
+ * 負荷はコア1個に対する割合（前回の出力からの実行時間 / 経過時間）
+ */
+void app_task_print_load(void);
+
+#endif  // __APP_TASKS_HPP__
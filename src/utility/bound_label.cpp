@@ -0,0 +1,20 @@
+#include "bound_label.hpp"
+
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+#include <Arduino.h>
+#endif
+
+BoundLabelBase::Stats BoundLabelBase::stats = {0, 0};
+
+void BoundLabelBase::printStats(void)
+{
+    uint32_t total = stats.updates + stats.skipped;
+    unsigned saved = (0 < total) ? (unsigned)((uint64_t)stats.skipped * 100 / total) : 0;
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+    Serial.printf("Labels: %lu updates, %lu unchanged (invalidations avoided), %u%% saved\n",
+                  (unsigned long)stats.updates, (unsigned long)stats.skipped, saved);
+#else
+    printf("Labels: %lu updates, %lu unchanged (invalidations avoided), %u%% saved\n", (unsigned long)stats.updates,
+           (unsigned long)stats.skipped, saved);
+#endif
+}
@@ -0,0 +1,128 @@
+#ifndef __BOUND_LABEL_HPP__
+#define __BOUND_LABEL_HPP__
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "lvgl.h"
+
+/**
+ * @brief ラベル更新の集計（全 BoundLabel 共通）
+ */
+class BoundLabelBase {
+public:
+    struct Stats {
+        uint32_t updates;  // LVGLへ反映した回数（テキスト・色）
+        uint32_t skipped;  // 変化がなく反映しなかった回数（＝省略した無効化）
+    };
+
+    static const Stats& getStats(void)
+    {
+        return stats;
+    }
+
+    static void printStats(void);
+
+protected:
+    static Stats stats;
+};
+
+/**
+ * @brief 値をラベルに表示するバインディング
+ * Formatter で固定長バッファに整形し、前回と同じテキスト・色なら LVGL に触れない
+ * （lv_label_set_text による無効化・再描画を起こさない）。
+ * ラベルを作り直したら bind() で結び直す。ラベルが削除されたら（lv_obj_clean() など）
+ * 結び付きは外れ、再び bind() するまで set() は何もしない。
+ * @tparam T 表示する値の型
+ * @tparam Formatter void operator()(char* buf, size_t size, const T& value) const
+ * @tparam N テキストバッファのサイズ
+ */
+template <typename T, typename Formatter, size_t N = 32>
+class BoundLabel : public BoundLabelBase {
+public:
+    BoundLabel() : label(nullptr), has_color(false), color()
+    {
+        text[0] = '\0';
+    }
+
+    void bind(lv_obj_t* obj)
+    {
+        label     = obj;
+        has_color = false;
+        text[0]   = '\0';
+        lv_label_set_text_static(label, text);  // 空テキストで同期（以降は set() のみで更新）
+        lv_obj_add_event_cb(label, onLabelDeleted, LV_EVENT_DELETE, this);
+    }
+
+    /**
+     * @return LVGLへ反映した場合 true
+     */
+    bool set(const T& value)
+    {
+        if (nullptr == label) {
+            return false;
+        }
+        char buf[N];
+        Formatter()(buf, sizeof(buf), value);
+        if (0 == strcmp(buf, text)) {
+            stats.skipped++;
+            return false;
+        }
+        memcpy(text, buf, sizeof(text));
+        lv_label_set_text_static(label, text);
+        stats.updates++;
+        return true;
+    }
+
+    bool setColor(lv_color_t new_color)
+    {
+        if (nullptr == label) {
+            return false;
+        }
+        if (has_color && lv_color_eq(color, new_color)) {
+            stats.skipped++;
+            return false;
+        }
+        has_color = true;
+        color     = new_color;
+        lv_obj_set_style_text_color(label, color, LV_PART_MAIN);
+        stats.updates++;
+        return true;
+    }
+
+    lv_obj_t* getObject(void) const
+    {
+        return label;
+    }
+
+private:
+    // 削除されたラベルを指したままにしない（結び直した後に古いラベルが削除された場合は何もしない）
+    static void onLabelDeleted(lv_event_t* e)
+    {
+        BoundLabel* self = static_cast<BoundLabel*>(lv_event_get_user_data(e));
+        if (self->label == lv_event_get_target(e)) {
+            self->label = nullptr;
+        }
+    }
+
+    lv_obj_t* label;
+    bool has_color;
+    lv_color_t color;
+    char text[N];  // 表示中のテキスト（ラベルはこのバッファを直接参照する）
+};
+
+/**
+ * @brief 文字列をそのまま表示する Formatter
+ */
+struct TextFormat {
+    void operator()(char* buf, size_t size, const char* value) const
+    {
+        snprintf(buf, size, "%s", value);
+    }
+};
+
+template <size_t N = 64>
+using BoundText = BoundLabel<const char*, TextFormat, N>;
+
+#endif  // __BOUND_LABEL_HPP__
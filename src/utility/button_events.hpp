@@ -0,0 +1,113 @@
+#ifndef __BUTTON_EVENTS_HPP__
+#define __BUTTON_EVENTS_HPP__
+
+#include <stdint.h>
+
+#include "hardware_interface.hpp"
+
+/**
+ * @brief ボタンのデバウンスとイベントキュー
+ * GPIO割り込み（またはポーリング）で得たエッジを時刻付きで受け取り、
+ * 最後に採用したエッジから DEBOUNCE_MS 以内の変化はチャタリングとして捨てる。
+ * 採用したエッジは ButtonEvent としてリングバッファに積み、アプリが pop() で取り出す。
+ * 割り込みと併用する場合、呼び出し側でクリティカルセクションを取ること
+ * （onEdge() はISRから呼べるようヘッダー内で定義している）。
+ */
+class ButtonEvents {
+public:
+    static const uint8_t MAX_BUTTONS  = 2;
+    static const uint8_t QUEUE_SIZE   = 16;  // 2のべき乗
+    static const uint32_t DEBOUNCE_MS = 20;
+
+    ButtonEvents() : head(0), tail(0), dropped(0)
+    {
+        for (uint8_t i = 0; i < MAX_BUTTONS; i++) {
+            pressed[i]      = false;
+            last_edge_ms[i] = 0;
+        }
+    }
+
+    /**
+     * @brief エッジを受け取る（ISRから呼ぶ）
+     * @param level_pressed エッジ後のレベル（true=押下）
+     * @param time_ms エッジの時刻
+     */
+    void onEdge(uint8_t button, bool level_pressed, uint32_t time_ms)
+    {
+        if (MAX_BUTTONS <= button || level_pressed == pressed[button]) {
+            return;
+        }
+        if (time_ms - last_edge_ms[button] < DEBOUNCE_MS) {
+            return;  // 直前のエッジのチャタリング
+        }
+        pressed[button]      = level_pressed;
+        last_edge_ms[button] = time_ms;
+        push(button, level_pressed, time_ms);
+    }
+
+    /**
+     * @brief 現在のレベルとの整合を取る（定期的に呼ぶ）
+     * デバウンス期間中に最後のエッジが来た場合など、割り込みで取りこぼした変化を補う
+     */
+    void sync(uint8_t button, bool level_pressed, uint32_t now_ms)
+    {
+        if (MAX_BUTTONS <= button || level_pressed == pressed[button]) {
+            return;
+        }
+        if (DEBOUNCE_MS <= now_ms - last_edge_ms[button]) {
+            pressed[button]      = level_pressed;
+            last_edge_ms[button] = now_ms;
+            push(button, level_pressed, now_ms);
+        }
+    }
+
+    bool isPressed(uint8_t button) const
+    {
+        return (button < MAX_BUTTONS) && pressed[button];
+    }
+
+    /**
+     * @brief 最も古いイベントを取り出す
+     * @return イベントがなければ false
+     */
+    bool pop(ButtonEvent* event)
+    {
+        if (head == tail) {
+            return false;
+        }
+        *event = queue[tail];
+        tail   = (uint8_t)((tail + 1) & (QUEUE_SIZE - 1));
+        return true;
+    }
+
+    /**
+     * @brief キューあふれで捨てたイベント数
+     */
+    uint32_t getDropped(void) const
+    {
+        return dropped;
+    }
+
+private:
+    volatile bool pressed[MAX_BUTTONS];
+    volatile uint32_t last_edge_ms[MAX_BUTTONS];
+    ButtonEvent queue[QUEUE_SIZE];
+    volatile uint8_t head;
+    volatile uint8_t tail;
+    volatile uint32_t dropped;
+
+    void push(uint8_t button, bool level_pressed, uint32_t time_ms)
+    {
+        uint8_t next = (uint8_t)((head + 1) & (QUEUE_SIZE - 1));
+        if (next == tail) {
+            dropped = dropped + 1;
+            return;
+        }
+        queue[head].time_ms = time_ms;
+        queue[head].button  = button;
+        queue[head].pressed = level_pressed;
+        head                = next;
+    }
+};
+
+#endif  // __BUTTON_EVENTS_HPP__
@@ -0,0 +1,165 @@
+#include "button_gestures.hpp"
+
+#include <string.h>
+
+ButtonGestures::ButtonGestures() : head(0), tail(0), dropped(0)
+{
+    memset(&config, 0, sizeof(config));
+    memset(state, 0, sizeof(state));
+}
+
+void ButtonGestures::configure(const Config& new_config)
+{
+    config = new_config;
+    reset();
+}
+
+void ButtonGestures::onEvent(const ButtonEvent& event)
+{
+    if (ButtonEvents::MAX_BUTTONS <= event.button) {
+        return;
+    }
+    if (event.pressed) {
+        onPress(event.button, event.time_ms);
+    } else {
+        onRelease(event.button, event.time_ms);
+    }
+}
+
+void ButtonGestures::onPress(uint8_t button, uint32_t time_ms)
+{
+    ButtonState& s     = state[button];
+    ButtonState& other = state[button ^ 1];
+    if (s.pressed) {
+        return;
+    }
+
+    // ダブル判定待ちの短押し：期限内なら2回目の押下でダブル押し、期限切れなら先に短押しを確定
+    if (s.pending_short) {
+        s.pending_short = false;
+        if (time_ms - s.release_ms <= config.double_ms) {
+            s.pressed    = true;
+            s.suppressed = true;
+            push(GestureType::DOUBLE, button, time_ms);
+            return;
+        }
+        push(GestureType::SHORT, button, s.release_ms);
+    }
+
+    s.pressed    = true;
+    s.suppressed = false;
+    s.long_fired = false;
+    s.press_ms   = time_ms;
+
+    // もう一方を押している間に押した：同時押し（両方とも離すまで無視）
+    if (other.pressed && !other.suppressed && !other.long_fired) {
+        s.suppressed     = true;
+        other.suppressed = true;
+        push(GestureType::CHORD, button, time_ms);
+    }
+}
+
+void ButtonGestures::onRelease(uint8_t button, uint32_t time_ms)
+{
+    ButtonState& s = state[button];
+    if (!s.pressed) {
+        return;
+    }
+    s.pressed = false;
+
+    if (s.suppressed) {
+        s.suppressed = false;
+        return;
+    }
+    if (s.long_fired) {
+        return;
+    }
+
+    // update() を待たずに押下・解放が届いた場合も押していた時間で判定する
+    uint32_t long_ms = config.long_ms[button];
+    if (0 < long_ms && long_ms <= time_ms - s.press_ms) {
+        s.long_fired = true;
+        push(GestureType::LONG, button, s.press_ms + long_ms);
+        return;
+    }
+
+    if (0 < config.double_ms) {
+        s.pending_short = true;
+        s.release_ms    = time_ms;
+    } else {
+        push(GestureType::SHORT, button, time_ms);
+    }
+}
+
+void ButtonGestures::update(uint32_t now_ms)
+{
+    for (uint8_t button = 0; button < ButtonEvents::MAX_BUTTONS; button++) {
+        ButtonState& s   = state[button];
+        uint32_t long_ms = config.long_ms[button];
+
+        if (s.pressed && !s.suppressed && 0 < long_ms) {
+            if (!s.long_fired) {
+                if (long_ms <= now_ms - s.press_ms) {
+                    s.long_fired = true;
+                    s.repeat_ms  = s.press_ms + long_ms;
+                    push(GestureType::LONG, button, s.repeat_ms);
+                }
+            } else if (0 < config.repeat_ms && config.repeat_ms <= now_ms - s.repeat_ms) {
+                s.repeat_ms = now_ms;
+                push(GestureType::REPEAT, button, now_ms);
+            }
+        }
+
+        if (s.pending_short && config.double_ms < now_ms - s.release_ms) {
+            s.pending_short = false;
+            push(GestureType::SHORT, button, s.release_ms);
+        }
+    }
+}
+
+bool ButtonGestures::pop(Gesture* gesture)
+{
+    if (head == tail) {
+        return false;
+    }
+    *gesture = queue[tail];
+    tail     = (uint8_t)((tail + 1) & (QUEUE_SIZE - 1));
+    return true;
+}
+
+void ButtonGestures::reset(void)
+{
+    for (uint8_t button = 0; button < ButtonEvents::MAX_BUTTONS; button++) {
+        ButtonState& s  = state[button];
+        s.suppressed    = s.pressed;
+        s.long_fired    = false;
+        s.pending_short = false;
+    }
+    head = 0;
+    tail = 0;
+}
+
+uint32_t ButtonGestures::heldMs(uint8_t button, uint32_t now_ms) const
+{
+    if (ButtonEvents::MAX_BUTTONS <= button) {
+        return 0;
+    }
+    const ButtonState& s = state[button];
+    if (!s.pressed || s.suppressed || s.long_fired) {
+        return 0;
+    }
+    return now_ms - s.press_ms;
+}
+
+void ButtonGestures::push(GestureType type, uint8_t button, uint32_t time_ms)
+{
+    uint8_t next = (uint8_t)((head + 1) & (QUEUE_SIZE - 1));
+    if (next == tail) {
+        dropped++;
+        return;
+    }
+    queue[head].type    = type;
+    queue[head].button  = button;
+    queue[head].time_ms = time_ms;
+    head                = next;
+}
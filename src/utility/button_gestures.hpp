@@ -0,0 +1,100 @@
+#ifndef __BUTTON_GESTURES_HPP__
+#define __BUTTON_GESTURES_HPP__
+
+#include <stdint.h>
+
+#include "button_events.hpp"
+
+/**
+ * @brief ボタン操作の種類
+ */
+enum class GestureType : uint8_t {
+    SHORT,   // 短押し（離した時点、ダブル判定が有効なら判定時間の経過後）
+    LONG,    // 長押し（押したまま long_ms 経過した時点）
+    DOUBLE,  // ダブル押し（短押しの後 double_ms 以内に再度押した時点）
+    CHORD,   // A+B同時押し（2つ目を押した時点、button は後から押したボタン）
+    REPEAT,  // 長押し後の押し続け（repeat_ms ごと）
+};
+
+/**
+ * @brief 認識したボタン操作
+ */
+struct Gesture {
+    GestureType type;
+    uint8_t button;    // ButtonEvent::A / ButtonEvent::B
+    uint32_t time_ms;  // 操作が確定した時刻
+};
+
+/**
+ * @brief ボタン操作の認識
+ * 時刻付きのボタンイベント（デバウンス済み）から短押し・長押し・ダブル押し・同時押し・押し続けを認識し、
+ * Gesture としてキューに積む。長押し・押し続け・ダブル判定の期限は update() で時刻を与えて判定する。
+ * 同時押しに使ったボタンや reset() 時に押されていたボタンは、離すまで他の操作として扱わない。
+ */
+class ButtonGestures {
+public:
+    static const uint8_t QUEUE_SIZE = 8;  // 2のべき乗
+
+    struct Config {
+        uint32_t long_ms[ButtonEvents::MAX_BUTTONS];  // 長押しの時間（0=長押しなし）
+        uint32_t double_ms;                           // ダブル押しの判定時間（0=なし、短押しを即時に確定）
+        uint32_t repeat_ms;                           // 押し続けの間隔（0=なし）
+    };
+
+    ButtonGestures();
+
+    /**
+     * @brief 設定を変更（認識中の状態は reset() と同様に破棄する）
+     */
+    void configure(const Config& config);
+
+    void onEvent(const ButtonEvent& event);
+    void update(uint32_t now_ms);
+
+    /**
+     * @brief 最も古い操作を取り出す
+     * @return 操作がなければ false
+     */
+    bool pop(Gesture* gesture);
+
+    /**
+     * @brief 認識中の状態とキューを破棄（画面遷移時に呼ぶ）
+     * 押されているボタンは離すまで無視する
+     */
+    void reset(void);
+
+    /**
+     * @brief 長押しの判定中のボタンを押している時間 [ms]
+     * @return 押していない・長押し確定済み・無視中は 0
+     */
+    uint32_t heldMs(uint8_t button, uint32_t now_ms) const;
+
+    uint32_t getDropped(void) const
+    {
+        return dropped;
+    }
+
+private:
+    struct ButtonState {
+        bool pressed;
+        bool suppressed;      // 離すまで無視（同時押し・ダブル押し・reset 後）
+        bool long_fired;      // 長押しを通知済み
+        bool pending_short;   // ダブル判定待ちの短押し
+        uint32_t press_ms;    // 押した時刻
+        uint32_t release_ms;  // 離した時刻（ダブル判定用）
+        uint32_t repeat_ms;   // 最後に長押し・押し続けを通知した時刻
+    };
+
+    Config config;
+    ButtonState state[ButtonEvents::MAX_BUTTONS];
+    Gesture queue[QUEUE_SIZE];
+    uint8_t head;
+    uint8_t tail;
+    uint32_t dropped;
+
+    void push(GestureType type, uint8_t button, uint32_t time_ms);
+    void onPress(uint8_t button, uint32_t time_ms);
+    void onRelease(uint8_t button, uint32_t time_ms);
+};
+
+#endif  // __BUTTON_GESTURES_HPP__
@@ -0,0 +1,121 @@
+#include "config_store.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+#include <Arduino.h>
+#endif
+
+ConfigStore::ConfigStore() : load_func(nullptr), save_func(nullptr), dirty(false), edit_ms(0)
+{
+    memset(&config, 0, sizeof(config));
+    memset(&saved, 0, sizeof(saved));
+    memset(&stats, 0, sizeof(stats));
+}
+
+bool ConfigStore::begin(LoadFunc load, SaveFunc save, const AppConfig& defaults)
+{
+    load_func = load;
+    save_func = save;
+    dirty     = false;
+
+    // 比較・CRCがパディングに左右されないよう、構造体はバイト列としてコピーする
+    memcpy(&config, &defaults, sizeof(config));
+    memcpy(&saved, &defaults, sizeof(saved));
+
+    uint8_t blob[sizeof(Header) + sizeof(AppConfig)];
+    size_t length = load_func ? load_func(blob, sizeof(blob)) : 0;
+    if (length != sizeof(blob)) {
+        return false;
+    }
+
+    Header header;
+    memcpy(&header, blob, sizeof(header));
+    const uint8_t* payload = blob + sizeof(header);
+    if (MAGIC != header.magic || VERSION != header.version || sizeof(AppConfig) != header.size ||
+        crc32(payload, sizeof(AppConfig)) != header.crc) {
+        return false;
+    }
+
+    memcpy(&config, payload, sizeof(config));
+    memcpy(&saved, payload, sizeof(saved));
+    return true;
+}
+
+AppConfig& ConfigStore::edit(uint32_t now_ms)
+{
+    dirty   = true;
+    edit_ms = now_ms;
+    stats.edits++;
+    return config;
+}
+
+bool ConfigStore::flush(uint32_t now_ms)
+{
+    if (!dirty || now_ms - edit_ms < COALESCE_MS) {
+        return false;
+    }
+    return write();
+}
+
+bool ConfigStore::flushNow(void)
+{
+    if (!dirty) {
+        return false;
+    }
+    return write();
+}
+
+bool ConfigStore::write(void)
+{
+    dirty = false;
+    if (0 == memcmp(&config, &saved, sizeof(config))) {
+        stats.unchanged++;
+        return false;
+    }
+
+    Header header;
+    memset(&header, 0, sizeof(header));
+    header.magic   = MAGIC;
+    header.version = VERSION;
+    header.size    = sizeof(AppConfig);
+    header.crc     = crc32(&config, sizeof(config));
+
+    uint8_t blob[sizeof(Header) + sizeof(AppConfig)];
+    memcpy(blob, &header, sizeof(header));
+    memcpy(blob + sizeof(header), &config, sizeof(config));
+    if (nullptr == save_func || !save_func(blob, sizeof(blob))) {
+        dirty = true;  // 次の flush() で再試行
+        return false;
+    }
+
+    memcpy(&saved, &config, sizeof(saved));
+    stats.writes++;
+    return true;
+}
+
+void ConfigStore::printStats(void) const
+{
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+    Serial.printf("Config: %lu edits, %lu writes, %lu unchanged%s\n", (unsigned long)stats.edits,
+                  (unsigned long)stats.writes, (unsigned long)stats.unchanged, dirty ? " (pending)" : "");
+#else
+    printf("Config: %lu edits, %lu writes, %lu unchanged%s\n", (unsigned long)stats.edits, (unsigned long)stats.writes,
+           (unsigned long)stats.unchanged, dirty ? " (pending)" : "");
+#endif
+}
+
+uint32_t ConfigStore::crc32(const void* data, size_t size)
+{
+    // CRC-32（IEEE 802.3、反転多項式 0xEDB88320）。設定は100バイト程度なのでテーブルは持たない
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint32_t crc         = 0xFFFFFFFF;
+    for (size_t i = 0; i < size; i++) {
+        crc ^= bytes[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
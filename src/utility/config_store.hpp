@@ -0,0 +1,116 @@
+#ifndef __CONFIG_STORE_HPP__
+#define __CONFIG_STORE_HPP__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hardware_interface.hpp"
+
+/**
+ * @brief アプリの設定（保存する内容、レイアウトを変えたら ConfigStore::VERSION を上げる）
+ */
+struct AppConfig {
+    struct {
+        char ssid[WIFI_SSID_SIZE];  // 空=未設定
+        char password[WIFI_PASSWORD_SIZE];
+    } wifi;
+    struct {
+        float scale;  // 重量センサーの換算係数（0=未校正、実装の既定値を使う）
+    } calibration;
+    struct {
+        uint8_t brightness;  // LCD輝度 0-255
+    } display;
+    struct {
+        uint32_t report_interval_ms;  // CPU負荷・ヒープ確保の出力間隔 [ms]（0=出力しない）
+    } telemetry;
+};
+
+/**
+ * @brief 設定ストア
+ * 起動時に1回だけ読み込んでRAMに保持し、読み出しはメモリから返す（NVSやファイルを開かない）。
+ * 変更はすぐには書き込まず、最後の変更から COALESCE_MS 経ってから flush() でまとめて書き込む
+ * （ボタンで明るさを何度も変えても書き込みは1回）。内容が保存済みと同じなら書き込まない。
+ * 保存形式はヘッダー（マジック・スキーマ版数・サイズ・CRC32）+ AppConfig。
+ * 版数・サイズ・CRCのどれかが合わなければ既定値から始める。
+ * アプリタスクからのみ使う。
+ */
+class ConfigStore {
+public:
+    static const uint32_t MAGIC       = 0x31474643;  // "CFG1"
+    static const uint16_t VERSION     = 1;
+    static const uint32_t COALESCE_MS = 2000;  // 最後の変更から書き込みまでの待ち [ms]
+
+    // 保存先（実機はNVS、エミュレーターはファイル）
+    typedef size_t (*LoadFunc)(void* data, size_t size);    // 読み込んだバイト数を返す（なければ0）
+    typedef bool (*SaveFunc)(const void* data, size_t size);
+
+    struct Stats {
+        uint32_t writes;     // 書き込み回数
+        uint32_t edits;      // 変更回数（書き込みにまとめられた分を含む）
+        uint32_t unchanged;  // 保存済みと同じで書き込まなかった回数
+    };
+
+    ConfigStore();
+
+    /**
+     * @brief 保存先から読み込む（起動時に1回）
+     * @param defaults 保存されていない・壊れている場合の値
+     * @return 保存された設定を読み込めたら true
+     */
+    bool begin(LoadFunc load, SaveFunc save, const AppConfig& defaults);
+
+    const AppConfig& get(void) const
+    {
+        return config;
+    }
+
+    /**
+     * @brief 変更用の参照を取得（書き込みは flush() で後から行う）
+     */
+    AppConfig& edit(uint32_t now_ms);
+
+    /**
+     * @brief 最後の変更から COALESCE_MS 経っていれば書き込む（周期的に呼ぶ）
+     * @return 書き込んだら true
+     */
+    bool flush(uint32_t now_ms);
+
+    /**
+     * @brief 待たずに書き込む（再起動の前など）
+     */
+    bool flushNow(void);
+
+    bool isDirty(void) const
+    {
+        return dirty;
+    }
+
+    const Stats& getStats(void) const
+    {
+        return stats;
+    }
+
+    void printStats(void) const;
+
+    static uint32_t crc32(const void* data, size_t size);
+
+private:
+    struct Header {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t size;  // sizeof(AppConfig)
+        uint32_t crc;   // AppConfig の CRC32
+    };
+
+    bool write(void);
+
+    LoadFunc load_func;
+    SaveFunc save_func;
+    AppConfig config;
+    AppConfig saved;  // 保存済みの内容（同じなら書き込まない）
+    bool dirty;
+    uint32_t edit_ms;  // 最後の変更の時刻
+    Stats stats;
+};
+
+#endif  // __CONFIG_STORE_HPP__
@@ -1,14 +1,19 @@
 #include "emulator_hardware.hpp"
 
-#if !defined(ARDUINO) && (__has_include(<SDL2/SDL.h>) || __has_include(<SDL.h>))
-// エミュレーター環境でのみコンパイル
+#if !defined(ARDUINO)
+// エミュレーター環境でのみコンパイル（SDLなしのヘッドレスを含む）
 
 #include <stdio.h>
 #include <cmath>
 #include <fstream>
+#include <stdlib.h>
 #include <string.h>
 
-#if __has_include(<SDL2/SDL.h>)
+#include "app_clock.hpp"
+
+#if defined(EMULATOR_HEADLESS)
+// ヘッドレス：キーボード入力なし（ボタン操作はセンサートレースから再生）
+#elif __has_include(<SDL2/SDL.h>)
 #include <SDL2/SDL.h>
 #elif __has_include(<SDL.h>)
 #include <SDL.h>
@@ -26,11 +31,23 @@ EmulatorHardware::EmulatorHardware()
     , gyro_y(0.0f)
     , gyro_z(0.0f)
     , weight_grams(0.0f)
-    , brightness(128)
     , battery_voltage(4.2f)
+    , brightness(128)
     , wifi_status(WiFiStatus::DISCONNECTED)
     , wifi_ip("0.0.0.0")
+    , trace_calib{0, 1.0f}
+    , trace_index(0)
+    , trace_button_index(0)
+    , trace_button_position(0)
+    , trace_start_ms(0)
+    , trace_raw(0)
+    , trace_active(false)
 {
+    memset(wifi_ssid, 0, sizeof(wifi_ssid));
+    memset(wifi_password, 0, sizeof(wifi_password));
+    for (uint8_t i = 0; i < ButtonEvents::MAX_BUTTONS; i++) {
+        trace_button_pressed[i] = false;
+    }
 }
 
 EmulatorHardware::~EmulatorHardware()
@@ -42,70 +59,221 @@ void EmulatorHardware::begin()
     printf("[Emulator Hardware] Initialized\n");
     printf("  Button A: Press 'A' key\n");
     printf("  Button B: Press 'B' key\n");
+
+    // センサートレースの再生（実機で SENSOR_TRACE_RECORD=1 により記録したログ）
+    const char* trace_path = getenv("SENSOR_TRACE");
+    if (trace_path && loadTrace(trace_path)) {
+        printf("  Sensor trace: %s (%u samples, %u button edges, %.1f s)\n", trace_path, (unsigned)trace.size(),
+               (unsigned)trace_buttons.size(), (trace.back().time_ms - trace.front().time_ms) / 1000.0f);
+    }
+}
+
+bool EmulatorHardware::loadTrace(const char* path)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        printf("[Emulator Hardware] Failed to open sensor trace: %s\n", path);
+        return false;
+    }
+
+    trace.clear();
+    trace_buttons.clear();
+    bool has_calib = false;
+    std::string line;
+    while (std::getline(file, line)) {
+        SensorTraceSample sample;
+        SensorTraceCalibration calib;
+        ButtonEvent edge;
+        char kind = sensor_trace_parse_line(line.c_str(), &sample, &calib, &edge);
+        if ('S' == kind) {
+            // 時刻が巻き戻るサンプル（再起動をまたいだログ）は無視
+            if (trace.empty() || trace.back().time_ms <= sample.time_ms) {
+                trace.push_back(sample);
+            }
+        } else if ('B' == kind) {
+            if (edge.button < ButtonEvents::MAX_BUTTONS
+                && (trace_buttons.empty() || trace_buttons.back().time_ms <= edge.time_ms)) {
+                trace_buttons.push_back(edge);
+            }
+        } else if ('H' == kind && !has_calib) {
+            // 起動時の校正情報のみ使用（以降の tare / 校正は記録されたボタン操作で再現される）
+            trace_calib = calib;
+            has_calib   = true;
+        }
+    }
+
+    if (trace.empty()) {
+        printf("[Emulator Hardware] No samples in sensor trace: %s\n", path);
+        return false;
+    }
+
+    if (trace_buttons.empty()) {
+        // エッジの記録がない古いトレース：サンプル時点のボタン状態の変化をエッジとして再生する
+        uint8_t previous = 0;
+        for (const SensorTraceSample& sample : trace) {
+            for (uint8_t i = 0; i < ButtonEvents::MAX_BUTTONS; i++) {
+                uint8_t bit = (uint8_t)(1u << i);  // SENSOR_TRACE_BUTTON_A / B
+                if ((sample.buttons ^ previous) & bit) {
+                    trace_buttons.push_back({sample.time_ms, i, 0 != (sample.buttons & bit)});
+                }
+            }
+            previous = sample.buttons;
+        }
+    }
+
+    // 再生はサンプルの範囲を繰り返すため、範囲外のエッジ（記録の開始前・終了後）は捨てる
+    uint32_t first = trace.front().time_ms;
+    uint32_t last  = trace.back().time_ms;
+    size_t count   = 0;
+    for (const ButtonEvent& edge : trace_buttons) {
+        if (first <= edge.time_ms && edge.time_ms <= last) {
+            trace_buttons[count++] = edge;
+        }
+    }
+    trace_buttons.resize(count);
+
+    trace_index           = 0;
+    trace_button_index    = 0;
+    trace_button_position = 0;
+    trace_active          = true;
+    trace_start_ms        = app_clock_millis();
+    return true;
 }
 
+///////////////////////////////////////
+/// @brief トレース先頭のサンプルからの再生位置 [ms]
+/// 末尾のサンプルに達したら先頭から繰り返す
+uint32_t EmulatorHardware::tracePosition(uint32_t now_ms)
+{
+    uint32_t length = trace.back().time_ms - trace.front().time_ms;
+    return (now_ms - trace_start_ms) % (length + 1);
+}
+
+///////////////////////////////////////
+/// @brief トレースを記録時刻どおりに再生
+/// 現在時刻以前で最新のサンプルを適用する
+void EmulatorHardware::updateTrace(uint32_t now_ms)
+{
+    uint32_t position = tracePosition(now_ms);
+    uint32_t base     = trace.front().time_ms;
+
+    if (position < trace[trace_index].time_ms - base) {
+        trace_index = 0;  // 先頭に戻った
+    }
+    while (trace_index + 1 < trace.size() && trace[trace_index + 1].time_ms - base <= position) {
+        trace_index++;
+    }
+
+    const SensorTraceSample& sample = trace[trace_index];
+    trace_raw    = sample.raw;
+    weight_grams = sensor_trace_to_grams(trace_calib, sample.raw);
+    accel_x      = sample.accel[0];
+    accel_y      = sample.accel[1];
+    accel_z      = sample.accel[2];
+    gyro_x       = sample.gyro[0];
+    gyro_y       = sample.gyro[1];
+    gyro_z       = sample.gyro[2];
+}
+
+///////////////////////////////////////
+/// @brief 記録されたボタンのエッジを記録時刻どおりに再生
+/// 前回から現在までのエッジを、記録時刻に相当する時刻でイベントキューへ供給する
+/// （ポーリング周期より短い押下も、押していた時間どおりにジェスチャー認識へ届く）
+/// @param keys_pressed キーボードのボタン状態（押していればトレースの解放より優先）
+void EmulatorHardware::replayTraceButtons(uint32_t now_ms, const bool* keys_pressed)
+{
+    uint32_t position = tracePosition(now_ms);
+    uint32_t base     = trace.front().time_ms;
+
+    if (position < trace_button_position) {
+        // 先頭に戻った：押したままのボタンは離す（update() のポーリングで解放を供給）
+        trace_button_index = 0;
+        for (uint8_t i = 0; i < ButtonEvents::MAX_BUTTONS; i++) {
+            trace_button_pressed[i] = false;
+        }
+    }
+    trace_button_position = position;
+
+    while (trace_button_index < trace_buttons.size()
+           && trace_buttons[trace_button_index].time_ms - base <= position) {
+        const ButtonEvent& edge = trace_buttons[trace_button_index++];
+        trace_button_pressed[edge.button] = edge.pressed;
+        button_events.onEdge(edge.button, keys_pressed[edge.button] || edge.pressed,
+                             now_ms - position + (edge.time_ms - base));
+    }
+}
+
+///////////////////////////////////////
+/// @brief ボタンの状態を更新（アプリタスクから呼ぶ、計測値は updateSensors()）
 void EmulatorHardware::update()
 {
-    // SDLイベントの処理
-    const Uint8* keystate = SDL_GetKeyboardState(NULL);
-    
     // 前回の状態を保存
     bool btnA_prev = btnA_pressed;
     bool btnB_prev = btnB_pressed;
     
     // 現在の状態を更新
+#if defined(SDL_h_)
+    // SDLイベントの処理
+    const Uint8* keystate = SDL_GetKeyboardState(NULL);
     btnA_pressed = keystate[SDL_SCANCODE_A] != 0;
     btnB_pressed = keystate[SDL_SCANCODE_B] != 0;
+#else
+    btnA_pressed = false;
+    btnB_pressed = false;
+#endif
+
+    // トレース再生中は記録されたボタン操作も反映
+    uint32_t now = app_clock_millis();
+    if (trace_active) {
+        bool keys_pressed[ButtonEvents::MAX_BUTTONS] = {btnA_pressed, btnB_pressed};
+        replayTraceButtons(now, keys_pressed);
+        btnA_pressed = btnA_pressed || trace_button_pressed[ButtonEvent::A];
+        btnB_pressed = btnB_pressed || trace_button_pressed[ButtonEvent::B];
+    }
     
     // wasPressed検出（立ち上がりエッジ）
     btnA_was_pressed = btnA_pressed && !btnA_prev;
     btnB_was_pressed = btnB_pressed && !btnB_prev;
-    
-    // モックIMUデータ（簡単なシミュレーション）
-    static float angle = 0.0f;
-    angle += 0.01f;
-    accel_x = std::sin(angle) * 0.1f;
-    accel_y = std::cos(angle) * 0.1f;
-    accel_z = 1.0f;
 
-    // モック重量データ（0g〜2000gの間で変動）
-    weight_grams = 1000.0f + std::sin(angle * 0.35f) * 1000.0f;
-    
-    // バッテリーレベルを徐々に減少（デモ用）
-    static int counter = 0;
-    if (++counter > 1000) {
-        battery_voltage -= 0.01f;
-        if (battery_voltage < 3.0f) battery_voltage = 4.2f;
-        counter = 0;
-    }
+    // 実機の割り込みの代わりにポーリングでエッジを供給
+    button_events.onEdge(ButtonEvent::A, btnA_pressed, now);
+    button_events.onEdge(ButtonEvent::B, btnB_pressed, now);
 }
 
-bool EmulatorHardware::isButtonAPressed()
+///////////////////////////////////////
+/// @brief 計測値（重量・IMU・バッテリー）を現在時刻に合わせて更新
+/// 計測値の読み出しから呼ぶ。計測値に触れるのは読み出す計測タスクだけにし、
+/// アプリタスクの update()（ボタンのみ）とは共有しない（実機でHX711・IMUに触れるのが計測タスクだけなのと同じ）
+void EmulatorHardware::updateSensors()
 {
-    return btnA_pressed;
-}
+    uint32_t now = app_clock_millis();
 
-bool EmulatorHardware::isButtonBPressed()
-{
-    return btnB_pressed;
-}
+    // バッテリー電圧を徐々に減少（デモ用、5秒ごとに 0.01V、3.0V を下回ったら 4.2V に戻る）
+    battery_voltage = 4.2f - 0.01f * (float)((now / 5000) % 121);
 
-bool EmulatorHardware::wasButtonAPressed()
-{
-    bool result = btnA_was_pressed;
-    btnA_was_pressed = false;  // 読み取り後クリア
-    return result;
+    if (trace_active) {
+        updateTrace(now);
+        return;
+    }
+
+    // モックIMUデータ（簡単なシミュレーション）
+    double angle = now * 0.002;
+    accel_x      = (float)std::sin(angle) * 0.1f;
+    accel_y      = (float)std::cos(angle) * 0.1f;
+    accel_z      = 1.0f;
+
+    // モック重量データ（0g〜2000gの間で変動）
+    weight_grams = 1000.0f + (float)std::sin(angle * 0.35) * 1000.0f;
 }
 
-bool EmulatorHardware::wasButtonBPressed()
+bool EmulatorHardware::popButtonEvent(ButtonEvent* event)
 {
-    bool result = btnB_was_pressed;
-    btnB_was_pressed = false;  // 読み取り後クリア
-    return result;
+    return button_events.pop(event);
 }
 
 void EmulatorHardware::getAccel(float* x, float* y, float* z)
 {
+    updateSensors();
     if (x) *x = accel_x;
     if (y) *y = accel_y;
     if (z) *z = accel_z;
@@ -113,6 +281,7 @@ void EmulatorHardware::getAccel(float* x, float* y, float* z)
 
 void EmulatorHardware::getGyro(float* x, float* y, float* z)
 {
+    updateSensors();
     if (x) *x = gyro_x;
     if (y) *y = gyro_y;
     if (z) *z = gyro_z;
@@ -120,11 +289,14 @@ void EmulatorHardware::getGyro(float* x, float* y, float* z)
 
 float EmulatorHardware::getBatteryVoltage()
 {
+    updateSensors();
     return battery_voltage;
 }
 
 int EmulatorHardware::getBatteryLevel()
 {
+    updateSensors();
+
     // 3.0V-4.2Vを0-100%に変換
     float level = (battery_voltage - 3.0f) / (4.2f - 3.0f) * 100.0f;
     if (level < 0.0f) level = 0.0f;
@@ -132,26 +304,40 @@ int EmulatorHardware::getBatteryLevel()
     return (int)level;
 }
 
-bool EmulatorHardware::hasWeightSensor()
+bool EmulatorHardware::tareWeightSensor()
 {
+    if (trace_active) {
+        updateSensors();
+        trace_calib.offset = trace_raw;
+    }
+    printf("[Emulator Weight] Tare done\n");
     return true;
 }
 
-float EmulatorHardware::getWeightGrams()
+bool EmulatorHardware::calibrateWeightSensor(float knownWeightGrams)
 {
-    return weight_grams;
+    if (trace_active) {
+        updateSensors();
+        if (knownWeightGrams <= 0.0f || trace_raw == trace_calib.offset) {
+            return false;
+        }
+        trace_calib.scale = (trace_raw - trace_calib.offset) / knownWeightGrams;
+    }
+    printf("[Emulator Weight] Calibrated with %.1fg\n", knownWeightGrams);
+    return true;
 }
 
-bool EmulatorHardware::tareWeightSensor()
+float EmulatorHardware::getWeightScale()
 {
-    printf("[Emulator Weight] Tare done\n");
-    return true;
+    return trace_calib.scale;
 }
 
-bool EmulatorHardware::calibrateWeightSensor(float knownWeightGrams)
+void EmulatorHardware::setWeightScale(float scale)
 {
-    printf("[Emulator Weight] Calibrated with %.1fg\n", knownWeightGrams);
-    return true;
+    // トレース再生中は記録された校正情報を使う（実機と同じ重量を再現するため）
+    if (!trace_active && 0.0f < scale) {
+        trace_calib.scale = scale;
+    }
 }
 
 void EmulatorHardware::setBrightness(uint8_t value)
@@ -165,96 +351,91 @@ uint8_t EmulatorHardware::getBrightness()
     return brightness;
 }
 
+// ====================================================================
+// 設定の保存先（エミュレーター用、カレントディレクトリの app_config.bin）
+// ====================================================================
+
+size_t EmulatorHardware::loadConfig(void* data, size_t size)
+{
+    FILE* file = fopen("app_config.bin", "rb");
+    if (nullptr == file) {
+        return 0;
+    }
+    size_t length = fread(data, 1, size, file);
+    fclose(file);
+    return length;
+}
+
+bool EmulatorHardware::saveConfig(const void* data, size_t size)
+{
+    FILE* file = fopen("app_config.bin", "wb");
+    if (nullptr == file) {
+        return false;
+    }
+    bool ok = (size == fwrite(data, 1, size, file));
+    ok      = (0 == fclose(file)) && ok;
+    printf("[Emulator Config] %s app_config.bin (%u bytes)\n", ok ? "Saved" : "Failed to save", (unsigned)size);
+    return ok;
+}
+
 // ====================================================================
 // WiFi機能実装（エミュレーター用）
 // ====================================================================
 
 bool EmulatorHardware::loadWiFiConfigFromFile()
 {
-    std::ifstream file("wifi_config.txt");
-    if (!file.is_open()) {
+    FILE* file = fopen("wifi_config.txt", "r");
+    if (nullptr == file) {
         return false;
     }
     
-    std::string line;
+    char line[128];
     bool has_ssid = false;
     bool has_password = false;
     
-    while (std::getline(file, line)) {
-        if (line.find("SSID=") == 0) {
-            wifi_ssid = line.substr(5);
+    while (fgets(line, sizeof(line), file)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (0 == strncmp(line, "SSID=", 5)) {
+            snprintf(wifi_ssid, sizeof(wifi_ssid), "%s", line + 5);
             has_ssid = true;
-        } else if (line.find("PASSWORD=") == 0) {
-            wifi_password = line.substr(9);
+        } else if (0 == strncmp(line, "PASSWORD=", 9)) {
+            snprintf(wifi_password, sizeof(wifi_password), "%s", line + 9);
             has_password = true;
         }
     }
     
-    file.close();
-    return has_ssid && has_password && !wifi_ssid.empty();
+    fclose(file);
+    return has_ssid && has_password && '\0' != wifi_ssid[0];
 }
 
-void EmulatorHardware::saveWiFiConfigToFile()
-{
-    std::ofstream file("wifi_config.txt");
-    if (file.is_open()) {
-        file << "SSID=" << wifi_ssid << std::endl;
-        file << "PASSWORD=" << wifi_password << std::endl;
-        file.close();
-        printf("[Emulator WiFi] Configuration saved to wifi_config.txt\n");
-    }
-}
-
-bool EmulatorHardware::hasWiFiConfig()
-{
-    return loadWiFiConfigFromFile();
-}
-
-bool EmulatorHardware::loadWiFiConfig(String& ssid, String& password)
+bool EmulatorHardware::loadWiFiConfig(char* ssid, size_t ssid_size, char* password, size_t password_size)
 {
     if (loadWiFiConfigFromFile()) {
-        ssid = wifi_ssid;
-        password = wifi_password;
+        snprintf(ssid, ssid_size, "%s", wifi_ssid);
+        snprintf(password, password_size, "%s", wifi_password);
         return true;
     }
     return false;
 }
 
-void EmulatorHardware::saveWiFiConfig(const String& ssid, const String& password)
-{
-    wifi_ssid = ssid;
-    wifi_password = password;
-    saveWiFiConfigToFile();
-}
-
-void EmulatorHardware::clearWiFiConfig()
-{
-    wifi_ssid.clear();
-    wifi_password.clear();
-    
-    // ファイルを削除
-    std::remove("wifi_config.txt");
-    printf("[Emulator WiFi] Configuration cleared\n");
-}
-
 WiFiStatus EmulatorHardware::getWiFiStatus()
 {
     return wifi_status;
 }
 
-bool EmulatorHardware::connectWiFi(const String& ssid, const String& password)
+bool EmulatorHardware::connectWiFi(const char* ssid, const char* password)
 {
-    printf("[Emulator WiFi] Connecting to '%s'...\n", ssid.c_str());
+    printf("[Emulator WiFi] Connecting to '%s'...\n", ssid);
     
-    wifi_ssid = ssid;
-    wifi_password = password;
+    snprintf(wifi_ssid, sizeof(wifi_ssid), "%s", ssid);
+    snprintf(wifi_password, sizeof(wifi_password), "%s", password);
     wifi_status = WiFiStatus::CONNECTING;
     
     // エミュレーターでは即座に接続成功とする
     wifi_status = WiFiStatus::CONNECTED;
     wifi_ip = "192.168.1.100";  // モックIPアドレス
     
-    printf("[Emulator WiFi] Connected! IP: %s\n", wifi_ip.c_str());
+    printf("[Emulator WiFi] Connected! IP: %s\n", wifi_ip);
     return true;
 }
 
@@ -282,7 +463,7 @@ int EmulatorHardware::scanNetworks(WiFiNetwork* networks, int maxNetworks)
     int count = (maxNetworks < 4) ? maxNetworks : 4;
     
     for (int i = 0; i < count; i++) {
-        networks[i].ssid = mock_ssids[i];
+        snprintf(networks[i].ssid, sizeof(networks[i].ssid), "%s", mock_ssids[i]);
         networks[i].rssi = mock_rssi[i];
         networks[i].isEncrypted = mock_encrypted[i];
     }
@@ -291,11 +472,11 @@ int EmulatorHardware::scanNetworks(WiFiNetwork* networks, int maxNetworks)
     return count;
 }
 
-bool EmulatorHardware::startAPMode(const String& ssid)
+bool EmulatorHardware::startAPMode(const char* ssid)
 {
-    printf("[Emulator WiFi] Starting AP mode: %s\n", ssid.c_str());
+    printf("[Emulator WiFi] Starting AP mode: %s\n", ssid);
     wifi_status = WiFiStatus::AP_MODE;
-    wifi_ssid = ssid;
+    snprintf(wifi_ssid, sizeof(wifi_ssid), "%s", ssid);
     wifi_ip = "192.168.4.1";
     return true;
 }
@@ -307,9 +488,9 @@ void EmulatorHardware::stopAPMode()
     wifi_ip = "0.0.0.0";
 }
 
-String EmulatorHardware::getIPAddress()
+void EmulatorHardware::getIPAddress(char* buf, size_t size)
 {
-    return wifi_ip;
+    snprintf(buf, size, "%s", wifi_ip);
 }
 
 #endif  // エミュレーター環境でのみコンパイル
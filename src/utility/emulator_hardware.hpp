@@ -1,79 +1,129 @@
 #ifndef __EMULATOR_HARDWARE_HPP__
 #define __EMULATOR_HARDWARE_HPP__
 
+#include "button_events.hpp"
 #include "hardware_interface.hpp"
+#include "sensor_trace.hpp"
 #include <string>
+#include <vector>
 
 /**
  * @brief エミュレーター環境用のハードウェア実装
  * SDLイベントやモックデータを使用
+ * HardwareInterface と同じ関数を持つが継承はしない（Hardware として直接呼ぶ、hardware.hpp）
  */
-class EmulatorHardware : public HardwareInterface {
+class EmulatorHardware {
 public:
     EmulatorHardware();
-    ~EmulatorHardware() override;
+    ~EmulatorHardware();
     
-    void begin() override;
-    void update() override;
+    void begin();
+    void update();
     
     // ボタン関連 (キーボードでシミュレート)
-    bool isButtonAPressed() override;
-    bool isButtonBPressed() override;
-    bool wasButtonAPressed() override;
-    bool wasButtonBPressed() override;
+    bool isButtonAPressed()
+    {
+        return btnA_pressed;
+    }
+    bool isButtonBPressed()
+    {
+        return btnB_pressed;
+    }
+    bool wasButtonAPressed()
+    {
+        bool result      = btnA_was_pressed;
+        btnA_was_pressed = false;  // 読み取り後クリア
+        return result;
+    }
+    bool wasButtonBPressed()
+    {
+        bool result      = btnB_was_pressed;
+        btnB_was_pressed = false;  // 読み取り後クリア
+        return result;
+    }
+    bool popButtonEvent(ButtonEvent* event);
     
     // IMU (モックデータ)
-    void getAccel(float* x, float* y, float* z) override;
-    void getGyro(float* x, float* y, float* z) override;
+    void getAccel(float* x, float* y, float* z);
+    void getGyro(float* x, float* y, float* z);
     
     // バッテリー (モックデータ)
-    float getBatteryVoltage() override;
-    int getBatteryLevel() override;
+    float getBatteryVoltage();
+    int getBatteryLevel();
 
     // 重量センサー (モックデータ)
-    bool hasWeightSensor() override;
-    float getWeightGrams() override;
-    bool tareWeightSensor() override;
-    bool calibrateWeightSensor(float knownWeightGrams) override;
+    bool hasWeightSensor()
+    {
+        return true;
+    }
+    float getWeightGrams()
+    {
+        updateSensors();
+        return weight_grams;
+    }
+    bool tareWeightSensor();
+    bool calibrateWeightSensor(float knownWeightGrams);
+    float getWeightScale();
+    void setWeightScale(float scale);
     
     // LCD輝度
-    void setBrightness(uint8_t brightness) override;
-    uint8_t getBrightness() override;
+    void setBrightness(uint8_t brightness);
+    uint8_t getBrightness();
     
-    // WiFi機能 (ファイルベース設定)
-    bool hasWiFiConfig() override;
-    bool loadWiFiConfig(String& ssid, String& password) override;
-    void saveWiFiConfig(const String& ssid, const String& password) override;
-    void clearWiFiConfig() override;
-    WiFiStatus getWiFiStatus() override;
-    bool connectWiFi(const String& ssid, const String& password) override;
-    void disconnectWiFi() override;
-    int scanNetworks(WiFiNetwork* networks, int maxNetworks) override;
-    bool startAPMode(const String& ssid) override;
-    void stopAPMode() override;
-    String getIPAddress() override;
+    // 設定の保存先 (app_config.bin)
+    size_t loadConfig(void* data, size_t size);
+    bool saveConfig(const void* data, size_t size);
+
+    // WiFi機能 (旧形式の設定は wifi_config.txt)
+    bool loadWiFiConfig(char* ssid, size_t ssid_size, char* password, size_t password_size);
+    WiFiStatus getWiFiStatus();
+    bool connectWiFi(const char* ssid, const char* password);
+    void disconnectWiFi();
+    int scanNetworks(WiFiNetwork* networks, int maxNetworks);
+    bool startAPMode(const char* ssid);
+    void stopAPMode();
+    void getIPAddress(char* buf, size_t size);
 
 private:
     bool btnA_pressed;
     bool btnB_pressed;
     bool btnA_was_pressed;
     bool btnB_was_pressed;
+    ButtonEvents button_events;  // 実機と同じデバウンス・イベントキュー（ポーリングで供給）
     
+    // 計測値（読み出す計測タスクだけが updateSensors() で更新する）
     float accel_x, accel_y, accel_z;
     float gyro_x, gyro_y, gyro_z;
     float weight_grams;
-    
-    uint8_t brightness;
     float battery_voltage;
+
+    uint8_t brightness;
     
     // WiFi関連
     WiFiStatus wifi_status;
-    std::string wifi_ssid;
-    std::string wifi_password;
-    std::string wifi_ip;
+    char wifi_ssid[WIFI_SSID_SIZE];
+    char wifi_password[WIFI_PASSWORD_SIZE];
+    const char* wifi_ip;
     
     bool loadWiFiConfigFromFile();
-    void saveWiFiConfigToFile();
+
+    // センサートレース再生（環境変数 SENSOR_TRACE でファイル指定）
+    std::vector<SensorTraceSample> trace;
+    std::vector<ButtonEvent> trace_buttons;  // 記録されたボタンのエッジ（B 行）
+    SensorTraceCalibration trace_calib;
+    size_t trace_index;
+    size_t trace_button_index;
+    uint32_t trace_button_position;                        // 前回のボタン再生位置（先頭に戻ったことの検出用）
+    bool trace_button_pressed[ButtonEvents::MAX_BUTTONS];  // 再生中のボタン状態
+    uint32_t trace_start_ms;
+    int32_t trace_raw;
+    bool trace_active;
+
+    bool loadTrace(const char* path);
+    uint32_t tracePosition(uint32_t now_ms);
+    void updateSensors();
+    void updateTrace(uint32_t now_ms);
+    void replayTraceButtons(uint32_t now_ms, const bool* keys_pressed);
 };
 
 #endif  // __EMULATOR_HARDWARE_HPP__
@@ -0,0 +1,35 @@
+#ifndef __HARDWARE_HPP__
+#define __HARDWARE_HPP__
+
+#include "hardware_interface.hpp"
+
+/**
+ * @brief ビルドごとのハードウェア実装（コンパイル時に選択）
+ * 1つのビルドで使う実装は1つなので、具象型を Hardware として直接呼ぶ。
+ * 仮想関数を経由しないため、ヘッダーに定義した関数（ボタン状態など）はインライン展開される。
+ */
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+#include "real_hardware.hpp"
+using Hardware = RealHardware;
+#else
+#include "emulator_hardware.hpp"
+using Hardware = EmulatorHardware;
+#endif
+
+// 静的に確保したインスタンス（ヒープを使わない）
+extern Hardware hardware_instance;
+
+/**
+ * @brief ハードウェアの取得
+ */
+inline Hardware& hardware()
+{
+    return hardware_instance;
+}
+
+/**
+ * @brief ハードウェアの初期化（起動時に1回、2回目以降は何もしない）
+ */
+void hardware_begin(void);
+
+#endif  // __HARDWARE_HPP__
@@ -1,21 +1,20 @@
-#include "hardware_interface.hpp"
-#include "emulator_hardware.hpp"
-#include "real_hardware.hpp"
+#include "hardware.hpp"
 
 // グローバルインスタンス
-static HardwareInterface* g_hardware = nullptr;
+Hardware hardware_instance;
+static HardwareAdapter<Hardware> hardware_adapter(hardware_instance);
+static bool hardware_started = false;
 
-HardwareInterface* getHardware()
+void hardware_begin(void)
 {
-    if (g_hardware == nullptr) {
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-        // 実機環境
-        g_hardware = new RealHardware();
-#else
-        // エミュレーター環境
-        g_hardware = new EmulatorHardware();
-#endif
-        g_hardware->begin();
+    if (!hardware_started) {
+        hardware_started = true;
+        hardware_instance.begin();
     }
-    return g_hardware;
+}
+
+HardwareInterface* getHardware()
+{
+    hardware_begin();
+    return &hardware_adapter;
 }
@@ -0,0 +1,79 @@
+#if defined(EMULATOR_HEADLESS)
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app_clock.hpp"
+#include "heap_audit.hpp"
+#include "lvgl_port_m5stack.hpp"
+
+void setup(void);
+void loop(void);
+void user_app_print_stats(void);
+
+// ヘッドレスエミュレーター
+// SDLウィンドウを使わず、仮想時計でアプリのループを実時間より高速に回す。
+//   --seconds N / --minutes N / --hours N : シミュレーション時間（既定 60秒）
+// センサー入力・ボタン操作は SENSOR_TRACE で指定したトレースから再生できる。
+// APP_STATIC_MEMORY のビルドでは、setup() 後にヒープ確保があれば終了コード1を返す。
+int main(int argc, char **argv)
+{
+    uint64_t duration_ms = 60ULL * 1000ULL;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        double value = atof(argv[i + 1]);
+        if (0 == strcmp(argv[i], "--seconds")) {
+            duration_ms = (uint64_t)(value * 1000.0);
+        } else if (0 == strcmp(argv[i], "--minutes")) {
+            duration_ms = (uint64_t)(value * 60.0 * 1000.0);
+        } else if (0 == strcmp(argv[i], "--hours")) {
+            duration_ms = (uint64_t)(value * 3600.0 * 1000.0);
+        } else {
+            printf("Unknown option: %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    auto wall_start = std::chrono::steady_clock::now();
+
+    setup();
+    lvgl_port_run();
+
+    // 32bitのミリ秒時計が一周しても経過時間で判定する
+    uint64_t elapsed_ms = 0;
+    uint64_t loops      = 0;
+    uint32_t last_ms    = app_clock_millis();
+    while (elapsed_ms < duration_ms) {
+        loop();
+        lvgl_port_run();
+
+        uint32_t now_ms = app_clock_millis();
+        elapsed_ms += now_ms - last_ms;
+        last_ms = now_ms;
+        loops++;
+    }
+
+    double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+    double sim_s  = elapsed_ms / 1000.0;
+    printf("Headless run: simulated %.1f s in %.3f s wall (x%.0f), %llu loops, %.2f us/loop\n", sim_s, wall_s,
+           (0.0 < wall_s) ? sim_s / wall_s : 0.0, (unsigned long long)loops,
+           (0 < loops) ? wall_s * 1e6 / loops : 0.0);
+    lvgl_port_print_flush_stats();
+    user_app_print_stats();
+
+#if APP_STATIC_MEMORY
+    // 静的メモリモード：定常状態でヒープを確保していないこと
+    HeapAuditStats heap;
+    heap_audit_get(&heap);
+    if (0 < heap.steady_allocs) {
+        printf("Static memory check FAILED: %lu allocations (%lu bytes) after setup\n",
+               (unsigned long)heap.steady_allocs, (unsigned long)heap.steady_bytes);
+        return 1;
+    }
+    printf("Static memory check: ok (no allocations after setup)\n");
+#endif
+    return 0;
+}
+
+#endif
@@ -0,0 +1,215 @@
+#include "heap_audit.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <new>
+
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+#include <Arduino.h>
+#endif
+
+static std::atomic<uint32_t> alloc_count(0);
+static std::atomic<uint32_t> free_count(0);
+static std::atomic<uint32_t> steady_alloc_count(0);
+static std::atomic<uint32_t> steady_alloc_bytes(0);
+static std::atomic<uint32_t> exempt_alloc_count(0);
+static std::atomic<bool> steady(false);
+static std::atomic<bool> exempt(false);
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+static uint32_t steady_free_heap = 0;  // 定常状態に入った時点の空きヒープ [bytes]
+#endif
+
+void heap_audit_mark_steady(void)
+{
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+    steady_free_heap = esp_get_free_heap_size();
+#endif
+    steady.store(true, std::memory_order_relaxed);
+}
+
+void heap_audit_set_exempt(bool value)
+{
+    exempt.store(value, std::memory_order_relaxed);
+}
+
+void heap_audit_get(HeapAuditStats* stats)
+{
+    stats->allocs        = alloc_count.load(std::memory_order_relaxed);
+    stats->frees         = free_count.load(std::memory_order_relaxed);
+    stats->steady_allocs = steady_alloc_count.load(std::memory_order_relaxed);
+    stats->steady_bytes  = steady_alloc_bytes.load(std::memory_order_relaxed);
+    stats->exempt_allocs = exempt_alloc_count.load(std::memory_order_relaxed);
+}
+
+void heap_audit_print(void)
+{
+    HeapAuditStats stats;
+    heap_audit_get(&stats);
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+    Serial.printf("Heap: %lu allocs, %lu frees, steady %lu allocs (%lu B), exempt %lu allocs, "
+                  "free %lu B (steady start %lu B, min %lu B)\n",
+                  (unsigned long)stats.allocs, (unsigned long)stats.frees, (unsigned long)stats.steady_allocs,
+                  (unsigned long)stats.steady_bytes, (unsigned long)stats.exempt_allocs,
+                  (unsigned long)esp_get_free_heap_size(), (unsigned long)steady_free_heap,
+                  (unsigned long)esp_get_minimum_free_heap_size());
+#else
+    printf("Heap: %lu allocs, %lu frees, steady %lu allocs (%lu B), exempt %lu allocs\n", (unsigned long)stats.allocs,
+           (unsigned long)stats.frees, (unsigned long)stats.steady_allocs, (unsigned long)stats.steady_bytes,
+           (unsigned long)stats.exempt_allocs);
+#endif
+}
+
+#if APP_STATIC_MEMORY
+///////////////////////////////////////////////////////////
+//      確保・解放を数える
+///////////////////////////////////////////////////////////
+
+static void count_alloc(size_t size)
+{
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    if (steady.load(std::memory_order_relaxed)) {
+        if (exempt.load(std::memory_order_relaxed)) {
+            exempt_alloc_count.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            steady_alloc_count.fetch_add(1, std::memory_order_relaxed);
+            steady_alloc_bytes.fetch_add((uint32_t)size, std::memory_order_relaxed);
+#if 2 <= APP_STATIC_MEMORY
+            abort();
+#endif
+        }
+    }
+}
+
+static void count_free(void* ptr)
+{
+    if (ptr) {
+        free_count.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+///////////////////////////////////////////////////////////
+//      C のアロケーターの置き換え（リンカーの --wrap で malloc / calloc / realloc / free を差し替える）
+//      Arduino の String や C ライブラリは malloc / realloc を直接使うため、operator new だけでは数えられない
+///////////////////////////////////////////////////////////
+
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+void* __wrap_malloc(size_t size)
+{
+    count_alloc(size);
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size)
+{
+    count_alloc(count * size);
+    return __real_calloc(count, size);
+}
+
+// 伸長・縮小も確保として数える（同じ場所で済むかはアロケーター次第）、size=0 は解放
+void* __wrap_realloc(void* ptr, size_t size)
+{
+    if (0 == size) {
+        count_free(ptr);
+    } else {
+        count_alloc(size);
+    }
+    return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void* ptr)
+{
+    count_free(ptr);
+    __real_free(ptr);
+}
+}
+
+///////////////////////////////////////////////////////////
+//      operator new / delete の置き換え（数えて元の malloc / free に委ねる）
+///////////////////////////////////////////////////////////
+
+static void* audited_alloc(size_t size)
+{
+    count_alloc(size);
+    return __real_malloc(0 == size ? 1 : size);
+}
+
+static void audited_free(void* ptr)
+{
+    count_free(ptr);
+    __real_free(ptr);
+}
+
+[[noreturn]] static void alloc_failed(void)
+{
+#if defined(__cpp_exceptions)
+    throw std::bad_alloc();
+#else
+    abort();
+#endif
+}
+
+void* operator new(size_t size)
+{
+    void* ptr = audited_alloc(size);
+    if (nullptr == ptr) {
+        alloc_failed();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    void* ptr = audited_alloc(size);
+    if (nullptr == ptr) {
+        alloc_failed();
+    }
+    return ptr;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return audited_alloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return audited_alloc(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    audited_free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    audited_free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    audited_free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    audited_free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    audited_free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    audited_free(ptr);
+}
+#endif  // APP_STATIC_MEMORY
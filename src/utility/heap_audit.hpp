@@ -0,0 +1,46 @@
+#ifndef __HEAP_AUDIT_HPP__
+#define __HEAP_AUDIT_HPP__
+
+#include <stdint.h>
+
+// 静的メモリモード（ビルドオプション）
+//   APP_STATIC_MEMORY=1 : operator new / delete と malloc / calloc / realloc / free を置き換え、
+//                         setup() 後（定常状態）のヒープ確保を数えて報告する
+//   APP_STATIC_MEMORY=2 : 定常状態で最初にヒープを確保した時点で abort する（デバッガーで呼び出し元を特定）
+// C のアロケーターはリンカーで差し替えるため、リンクに次のオプションが必要：
+//   -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free
+// 未定義なら数えない（関数は呼べるが統計は0のまま）。
+#ifndef APP_STATIC_MEMORY
+#define APP_STATIC_MEMORY 0
+#endif
+
+/**
+ * @brief ヒープ確保の統計
+ */
+struct HeapAuditStats {
+    uint32_t allocs;         // 確保回数（起動から）
+    uint32_t frees;          // 解放回数（起動から）
+    uint32_t steady_allocs;  // 定常状態での確保回数（除外中を除く）
+    uint32_t steady_bytes;   // 定常状態で確保したバイト数（除外中を除く）
+    uint32_t exempt_allocs;  // 除外中の確保回数（WiFi設定ポータルなど）
+};
+
+/**
+ * @brief ここから定常状態として数える（setup() の最後に呼ぶ）
+ */
+void heap_audit_mark_steady(void);
+
+/**
+ * @brief 定常状態の確保から除外する（true の間の確保は exempt_allocs に数える）
+ * WiFi設定ポータル（Arduinoの WebServer はリクエストごとにヒープを使う）の動作中に使う
+ */
+void heap_audit_set_exempt(bool exempt);
+
+void heap_audit_get(HeapAuditStats* stats);
+
+/**
+ * @brief 統計を出力（実機では空きヒープの最小値も出力）
+ */
+void heap_audit_print(void);
+
+#endif  // __HEAP_AUDIT_HPP__
@@ -0,0 +1,62 @@
+#ifndef __LVGL_BUFFER_PLAN_HPP__
+#define __LVGL_BUFFER_PLAN_HPP__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief LVGL描画バッファの構成
+ */
+struct LvglBufferPlan {
+    uint32_t lines;  // バッファ1つの行数
+    uint8_t count;   // バッファ数（2=ダブルバッファ、0=確保できない）
+    size_t bytes;    // バッファ1つのバイト数
+};
+
+/**
+ * @brief 空きメモリから描画バッファの構成を決める
+ * 空き容量から headroom（WiFi・Webサーバー用）を残した範囲で、ダブルバッファを優先して最大の行数を選ぶ。
+ * ダブルバッファが min_lines 行でも収まらない場合はシングルバッファにする。
+ * 行数は画面の高さを上限とし、16行（タイルキャッシュの1段）単位に切り下げる。
+ * @param free_bytes 確保できる空き容量
+ * @param largest_block 最大の空きブロック（バッファ1つはこれ以下）
+ */
+inline LvglBufferPlan lvgl_plan_draw_buffers(uint32_t width, uint32_t height, uint32_t bytes_per_pixel,
+                                             size_t free_bytes, size_t largest_block, size_t headroom,
+                                             uint32_t min_lines, uint32_t max_lines)
+{
+    const uint32_t ALIGN_LINES = 16;
+    size_t row_bytes           = (size_t)width * bytes_per_pixel;
+    size_t budget              = (headroom < free_bytes) ? free_bytes - headroom : 0;
+    if (height < max_lines) {
+        max_lines = height;
+    }
+    if (max_lines < min_lines) {
+        min_lines = max_lines;
+    }
+
+    LvglBufferPlan plan = {0, 0, 0};
+    if (0 == row_bytes) {
+        return plan;
+    }
+    for (uint8_t count = 2; 1 <= count; count--) {
+        size_t fit   = budget / count;
+        fit          = (largest_block < fit) ? largest_block : fit;
+        size_t lines = fit / row_bytes;
+        if (max_lines < lines) {
+            lines = max_lines;
+        }
+        if (ALIGN_LINES <= lines && lines < max_lines) {
+            lines -= lines % ALIGN_LINES;
+        }
+        if (min_lines <= lines && 0 < lines) {
+            plan.lines = (uint32_t)lines;
+            plan.count = count;
+            plan.bytes = lines * row_bytes;
+            return plan;
+        }
+    }
+    return plan;
+}
+
+#endif  // __LVGL_BUFFER_PLAN_HPP__
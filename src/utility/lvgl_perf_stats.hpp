@@ -0,0 +1,144 @@
+#ifndef __LVGL_PERF_STATS_HPP__
+#define __LVGL_PERF_STATS_HPP__
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief 描画性能の集計（一定時間ごとの窓単位）
+ * 1フレーム（LV_EVENT_RENDER_START〜RENDER_READY）の時間からフラッシュ時間を引いたものを描画時間とし、
+ * フラッシュ時間・フラッシュ領域の面積分布と合わせて窓ごとに合計/最大を取る。
+ * DMAで非同期に転送する場合は、フラッシュ関数内で待った時間を描画時間から除き、
+ * フラッシュ時間はフレーム最初の転送開始から最後の転送完了（transferDone()）までとする。
+ */
+class PerfStats {
+public:
+    static const int AREA_BINS = 5;  // 面積 [px] : <=256, <=1024, <=4096, <=16384, それ以上
+
+    struct Window {
+        uint32_t duration_ms;      // 窓の長さ
+        uint32_t frames;           // 描画したフレーム数
+        uint32_t render_us_total;  // 描画時間（フラッシュを除く）
+        uint32_t render_us_max;
+        uint32_t flush_us_total;   // フラッシュ時間
+        uint32_t flush_us_max;     // 1フレーム内のフラッシュ合計の最大
+        uint32_t flushes;          // フラッシュ回数
+        uint32_t area_hist[AREA_BINS];
+    };
+
+    PerfStats()
+        : frame_start_us(0),
+          frame_flush_us(0),
+          in_frame(false),
+          transfer_pending(false),
+          transfer_start_us(0),
+          window_start_ms(0),
+          current()
+    {
+    }
+
+    void frameStart(uint32_t now_us)
+    {
+        frame_start_us = now_us;
+        frame_flush_us = 0;
+        in_frame       = true;
+    }
+
+    void frameEnd(uint32_t now_us)
+    {
+        if (!in_frame) {
+            return;
+        }
+        in_frame           = false;
+        uint32_t total_us  = now_us - frame_start_us;
+        uint32_t render_us = (frame_flush_us < total_us) ? total_us - frame_flush_us : 0;
+        current.frames++;
+        current.render_us_total += render_us;
+        if (current.render_us_max < render_us) {
+            current.render_us_max = render_us;
+        }
+        if (!transfer_pending) {
+            addFlushTime(frame_flush_us);
+        }
+    }
+
+    void flushDone(uint32_t pixels, uint32_t elapsed_us)
+    {
+        frame_flush_us += elapsed_us;
+        current.flushes++;
+        current.area_hist[areaBin(pixels)]++;
+    }
+
+    /**
+     * @brief DMA転送を開始してフラッシュ関数から戻った（非同期）
+     * @param start_us フラッシュ関数に入った時刻
+     * @param blocked_us フラッシュ関数内で待った時間（前の転送の完了待ちなど）
+     */
+    void flushQueued(uint32_t pixels, uint32_t start_us, uint32_t blocked_us)
+    {
+        if (!transfer_pending) {
+            transfer_pending  = true;
+            transfer_start_us = start_us;
+        }
+        frame_flush_us += blocked_us;
+        current.flushes++;
+        current.area_hist[areaBin(pixels)]++;
+    }
+
+    /**
+     * @brief フレーム最後のDMA転送が完了した（非同期、frameEnd() の後に呼ぶ）
+     */
+    void transferDone(uint32_t now_us)
+    {
+        if (!transfer_pending) {
+            return;
+        }
+        transfer_pending = false;
+        addFlushTime(now_us - transfer_start_us);
+    }
+
+    /**
+     * @brief 窓の区切り
+     * @return window_ms 経過していれば out に窓の集計を書き込み、新しい窓を始めて true
+     */
+    bool roll(uint32_t now_ms, uint32_t window_ms, Window* out)
+    {
+        uint32_t elapsed = now_ms - window_start_ms;
+        if (elapsed < window_ms) {
+            return false;
+        }
+        *out             = current;
+        out->duration_ms = elapsed;
+        memset(&current, 0, sizeof(current));
+        window_start_ms = now_ms;
+        return true;
+    }
+
+    static int areaBin(uint32_t pixels)
+    {
+        int bin = 0;
+        for (uint32_t limit = 256; bin < AREA_BINS - 1 && limit < pixels; limit *= 4) {
+            bin++;
+        }
+        return bin;
+    }
+
+private:
+    void addFlushTime(uint32_t flush_us)
+    {
+        current.flush_us_total += flush_us;
+        if (current.flush_us_max < flush_us) {
+            current.flush_us_max = flush_us;
+        }
+    }
+
+    uint32_t frame_start_us;
+    uint32_t frame_flush_us;  // フラッシュ関数内の時間（描画時間から除く）
+    bool in_frame;
+    bool transfer_pending;  // 完了していないDMA転送がある
+    uint32_t transfer_start_us;
+    uint32_t window_start_ms;
+    Window current;
+};
+
+#endif  // __LVGL_PERF_STATS_HPP__
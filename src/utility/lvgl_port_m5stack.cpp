@@ -1,4 +1,11 @@
 #include "lvgl_port_m5stack.hpp"
+#include "app_clock.hpp"
+#include "app_tasks.hpp"
+#include "lvgl_buffer_plan.hpp"
+#include "lvgl_perf_stats.hpp"
+#include "lvgl_refresh_governor.hpp"
+#include "lvgl_tile_cache.hpp"
+#include <cstdio>   // for printf
 #include <cstdlib>  // for aligned_alloc
 #include <cstring>  // for memset
 
@@ -8,6 +15,8 @@
 
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
 static SemaphoreHandle_t xGuiSemaphore;
+#elif defined(EMULATOR_HEADLESS)
+// ヘッドレスは単一スレッドで lv_timer_handler() を呼ぶためロック不要
 #elif !defined(ARDUINO) && (__has_include(<SDL2/SDL.h>) || __has_include(<SDL.h>))
 static SDL_mutex *xGuiMutex;
 #endif
@@ -16,28 +25,208 @@ static SDL_mutex *xGuiMutex;
 #define LV_BUFFER_LINE 120
 #endif
 
+// Device without PSRAM: draw buffers are sized at boot from the free DMA-capable heap
+// (up to LV_BUFFER_LINE lines, double-buffered when it fits), keeping this much free
+// for WiFi and the web server
+#ifndef LVGL_PORT_HEAP_HEADROOM
+#define LVGL_PORT_HEAP_HEADROOM (80 * 1024)
+#endif
+#ifndef LVGL_PORT_BUFFER_MIN_LINES
+#define LVGL_PORT_BUFFER_MIN_LINES 16
+#endif
+
+// Skip SPI transfers of 16x16 tiles whose pixels did not change since the last flush
+#ifndef LVGL_PORT_TILE_CACHE
+#define LVGL_PORT_TILE_CACHE 1
+#endif
+
+// Render/flush timing is aggregated over windows of this length (overlay refresh rate)
+#ifndef LVGL_PORT_PERF_WINDOW_MS
+#define LVGL_PORT_PERF_WINDOW_MS 1000
+#endif
+
+// Print the performance window as a JSON line at this interval (0 = off)
+#ifndef LVGL_PORT_PERF_DUMP_MS
+#if defined(ARDUINO) || defined(EMULATOR_HEADLESS)
+#define LVGL_PORT_PERF_DUMP_MS 0
+#else
+#define LVGL_PORT_PERF_DUMP_MS 10000
+#endif
+#endif
+
+static_assert(PerfStats::AREA_BINS == LVGL_PORT_PERF_AREA_BINS, "area histogram size mismatch");
+
+static TileCache tile_cache;
+static PerfStats perf_stats;
+static lvgl_port_perf_t perf_last;     // last completed window
+static lv_obj_t *perf_overlay = NULL;  // created on the first toggle
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// Refresh governor: full rate (LV_DEF_REFR_PERIOD) while the screen is being invalidated,
+// LVGL_PORT_IDLE_PERIOD_MS once nothing changed for LVGL_PORT_ACTIVE_HOLD_MS
+#ifndef LVGL_PORT_IDLE_PERIOD_MS
+#define LVGL_PORT_IDLE_PERIOD_MS 250
+#endif
+#ifndef LVGL_PORT_ACTIVE_HOLD_MS
+#define LVGL_PORT_ACTIVE_HOLD_MS 500
+#endif
+
+static RefreshGovernor governor(LV_DEF_REFR_PERIOD, LVGL_PORT_IDLE_PERIOD_MS, LVGL_PORT_ACTIVE_HOLD_MS);
+static uint32_t governor_applied_period = 0;
+static bool invalidate_pending          = false;  // set under the GUI lock, see lvgl_port_unlock()
+
+#if LVGL_USE_V9 == 1
+// Record activity for the governor and grow invalidated areas to the tile grid
+// so that most flushes cover whole tiles
+static void lvgl_invalidate_area_cb(lv_event_t *e)
+{
+    invalidate_pending = true;
+    governor.markActivity(app_clock_millis());
+
+    if (tile_cache.isEnabled()) {
+        lv_area_t *area    = (lv_area_t *)lv_event_get_param(e);
+        lv_display_t *disp = (lv_display_t *)lv_event_get_current_target(e);
+        TileCache::alignArea(&area->x1, &area->y1, &area->x2, &area->y2, lv_display_get_horizontal_resolution(disp),
+                             lv_display_get_vertical_resolution(disp));
+    }
+}
+
+// A frame is everything between RENDER_START and RENDER_READY; the flush callbacks
+// report their own time so it can be separated from rendering
+static void lvgl_render_event_cb(lv_event_t *e)
+{
+    if (lv_event_get_code(e) == LV_EVENT_RENDER_START) {
+        perf_stats.frameStart(app_clock_micros());
+    } else {
+        perf_stats.frameEnd(app_clock_micros());
+    }
+}
+
+static void lvgl_perf_timer_cb(lv_timer_t *timer);
+
+static void lvgl_display_hooks_init(lv_display_t *disp)
+{
+    tile_cache.begin(lv_display_get_horizontal_resolution(disp), lv_display_get_vertical_resolution(disp),
+                     LVGL_PORT_TILE_CACHE != 0);
+    lv_display_add_event_cb(disp, lvgl_invalidate_area_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+    lv_display_add_event_cb(disp, lvgl_render_event_cb, LV_EVENT_RENDER_START, NULL);
+    lv_display_add_event_cb(disp, lvgl_render_event_cb, LV_EVENT_RENDER_READY, NULL);
+    lv_timer_create(lvgl_perf_timer_cb, LVGL_PORT_PERF_WINDOW_MS, NULL);
+}
+
+static void lvgl_perf_overlay_update(void)
+{
+    const lvgl_port_perf_t &p = perf_last;
+    char text[64];
+    snprintf(text, sizeof(text), "%lu.%lufps R%lu/%luus\nF%lu/%luus H%u%% fr%u%%", (unsigned long)(p.fps_x10 / 10),
+             (unsigned long)(p.fps_x10 % 10), (unsigned long)p.render_us_avg, (unsigned long)p.render_us_max,
+             (unsigned long)p.flush_us_avg, (unsigned long)p.flush_us_max, (unsigned)p.heap_used_pct,
+             (unsigned)p.heap_frag_pct);
+    lv_label_set_text(perf_overlay, text);
+}
+
+// Closes a window: derive the averages, sample the LVGL heap, refresh the overlay and
+// print the JSON line when due. The overlay redraw itself is part of the next window.
+static void lvgl_perf_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    PerfStats::Window w;
+    if (!perf_stats.roll(app_clock_millis(), LVGL_PORT_PERF_WINDOW_MS, &w)) {
+        return;
+    }
+
+    lvgl_port_perf_t &p = perf_last;
+    p.window_ms         = w.duration_ms;
+    p.frames            = w.frames;
+    p.fps_x10           = (0 < w.duration_ms) ? (uint32_t)((uint64_t)w.frames * 10000 / w.duration_ms) : 0;
+    p.render_us_avg     = (0 < w.frames) ? w.render_us_total / w.frames : 0;
+    p.render_us_max     = w.render_us_max;
+    p.flush_us_avg      = (0 < w.frames) ? w.flush_us_total / w.frames : 0;
+    p.flush_us_max      = w.flush_us_max;
+    p.flushes           = w.flushes;
+    memcpy(p.area_hist, w.area_hist, sizeof(p.area_hist));
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    p.heap_total        = mon.total_size;
+    p.heap_free         = mon.free_size;
+    p.heap_free_biggest = mon.free_biggest_size;
+    p.heap_max_used     = mon.max_used;
+    p.heap_used_pct     = mon.used_pct;
+    p.heap_frag_pct     = mon.frag_pct;
+
+    if (perf_overlay && !lv_obj_has_flag(perf_overlay, LV_OBJ_FLAG_HIDDEN)) {
+        lvgl_perf_overlay_update();
+    }
+
+#if LVGL_PORT_PERF_DUMP_MS > 0
+    static uint32_t last_dump_ms = 0;
+    uint32_t now_ms              = app_clock_millis();
+    if (LVGL_PORT_PERF_DUMP_MS <= now_ms - last_dump_ms && 0 < w.frames) {
+        last_dump_ms = now_ms;
+        lvgl_port_print_perf_json();
+    }
+#endif
+}
+#endif
+
+// Run the LVGL timers once with the governed refresh period.
+// Only the display refresh timer is governed: a polled input device keeps its
+// LV_DEF_REFR_PERIOD read timer. The app's button keypad is in LV_INDEV_MODE_EVENT
+// (read on each button edge), so an idle screen really sleeps for the idle period.
+// Returns how long the caller may sleep before the next run.
+static uint32_t lvgl_governor_run(void)
+{
+#if LVGL_USE_V9 == 1
+    uint32_t period = governor.refreshPeriod(app_clock_millis());
+    if (period != governor_applied_period) {
+        governor_applied_period = period;
+        lv_display_t *disp      = lv_display_get_default();
+        if (disp) {
+            lv_timer_set_period(lv_display_get_refr_timer(disp), period);
+        }
+    }
+#endif
+    invalidate_pending = false;
+    uint32_t start_us  = app_clock_micros();
+    uint32_t next_ms   = lv_timer_handler();
+    app_task_add_busy(APP_TASK_LVGL, app_clock_micros() - start_us);
+    return governor.sleepMs(next_ms);
+}
+
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
+static TaskHandle_t lvgl_task_handle = NULL;
+
+#if LVGL_USE_V8 == 1
 static void lvgl_tick_timer(void *arg)
 {
     (void)arg;
     lv_tick_inc(10);
 }
+#endif
+
+// Sleeps until the next LVGL timer is due or until lvgl_port_unlock() reports an invalidation
 static void lvgl_rtos_task(void *pvParameter)
 {
     (void)pvParameter;
+    lvgl_task_handle = xTaskGetCurrentTaskHandle();
     while (1) {
+        uint32_t sleep_ms = 10;
         if (pdTRUE == xSemaphoreTake(xGuiSemaphore, portMAX_DELAY)) {
-            lv_timer_handler();
+            sleep_ms = lvgl_governor_run();
             xSemaphoreGive(xGuiSemaphore);
         }
-        vTaskDelay(pdMS_TO_TICKS(10));
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(sleep_ms));
     }
 }
+#elif defined(EMULATOR_HEADLESS)
 #elif !defined(ARDUINO) && (__has_include(<SDL2/SDL.h>) || __has_include(<SDL.h>))
+static SDL_sem *lvgl_wake_sem;
+
+#if LVGL_USE_V8 == 1
 static uint32_t lvgl_tick_timer(uint32_t interval, void *param)
 {
     (void)interval;
@@ -45,22 +234,65 @@ static uint32_t lvgl_tick_timer(uint32_t interval, void *param)
     lv_tick_inc(10);
     return 10;
 }
+#endif
 
-static int lvgl_sdl_thread(void *data)
+static void lvgl_sdl_thread(void *data)
 {
     (void)data;
     while (1) {
+        uint32_t sleep_ms = 10;
         if (SDL_LockMutex(xGuiMutex) == 0) {
-            lv_timer_handler();
+            sleep_ms = lvgl_governor_run();
             SDL_UnlockMutex(xGuiMutex);
         }
-        SDL_Delay(10);
+        SDL_SemWaitTimeout(lvgl_wake_sem, sleep_ms);
     }
-    return 0;
 }
 #endif
 
-#if LVGL_USE_V8 == 1
+#if defined(EMULATOR_HEADLESS)
+#ifndef HEADLESS_WIDTH
+#define HEADLESS_WIDTH 240
+#endif
+#ifndef HEADLESS_HEIGHT
+#define HEADLESS_HEIGHT 135
+#endif
+
+// Headless emulator: LVGL renders into the draw buffers, nothing is pushed anywhere.
+// The tick source is the virtual clock, so the app can run faster than real time.
+// The tile cache still runs so the transfer savings are reported like on the device.
+static void lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    uint32_t start_us = app_clock_micros();
+    tile_cache.flush((const uint16_t *)px_map, area->x1, area->y1, area->x2, area->y2,
+                     [](int, int, int, int, const uint16_t *, int) {});
+    perf_stats.flushDone(lv_area_get_size(area), app_clock_micros() - start_us);
+    lv_display_flush_ready(disp);
+}
+
+void lvgl_port_init(void)
+{
+    lv_init();
+    lv_tick_set_cb(app_clock_millis);
+
+    static lv_display_t *disp = lv_display_create(HEADLESS_WIDTH, HEADLESS_HEIGHT);
+    if (disp == NULL) {
+        LV_LOG_ERROR("lv_display_create failed");
+        printf("ERROR: lv_display_create failed!\n");
+        return;
+    }
+    lv_display_set_flush_cb(disp, lvgl_flush_cb);
+    lvgl_display_hooks_init(disp);
+
+    static uint8_t buf1[HEADLESS_WIDTH * LV_BUFFER_LINE * 2] __attribute__((aligned(LV_DRAW_BUF_ALIGN)));
+    lv_display_set_buffers(disp, (void *)buf1, NULL, sizeof(buf1), LV_DISPLAY_RENDER_MODE_PARTIAL);
+}
+
+void lvgl_port_run(void)
+{
+    (void)lvgl_governor_run();
+}
+#elif LVGL_USE_V8 == 1
 static lv_disp_draw_buf_t draw_buf;
 static void lvgl_flush_cb(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p)
 {
@@ -163,12 +395,16 @@ void lvgl_port_init(M5GFX &gfx)
     disp_drv.user_data = &gfx;
     lv_disp_drv_register(&disp_drv);
 
-    static lv_indev_drv_t indev_drv;
-    lv_indev_drv_init(&indev_drv);
-    indev_drv.type      = LV_INDEV_TYPE_POINTER;
-    indev_drv.read_cb   = lvgl_read_cb;
-    indev_drv.user_data = &gfx;
-    lv_indev_t *indev   = lv_indev_drv_register(&indev_drv);
+    // Pointer input only when the panel has a touch controller (StickC Plus2 has none,
+    // buttons are registered by the app as a keypad)
+    if (gfx.touch()) {
+        static lv_indev_drv_t indev_drv;
+        lv_indev_drv_init(&indev_drv);
+        indev_drv.type      = LV_INDEV_TYPE_POINTER;
+        indev_drv.read_cb   = lvgl_read_cb;
+        indev_drv.user_data = &gfx;
+        lv_indev_drv_register(&indev_drv);
+    }
 
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
     xGuiSemaphore                                     = xSemaphoreCreateMutex();
@@ -176,42 +412,89 @@ void lvgl_port_init(M5GFX &gfx)
     esp_timer_handle_t periodic_timer;
     ESP_ERROR_CHECK(esp_timer_create(&periodic_timer_args, &periodic_timer));
     ESP_ERROR_CHECK(esp_timer_start_periodic(periodic_timer, 10 * 1000));
-    xTaskCreate(lvgl_rtos_task, "lvgl_rtos_task", 4096, NULL, 1, NULL);
+    app_task_start(APP_TASK_LVGL, lvgl_rtos_task, NULL);  // core/priority from APP_TASK_PLAN
 #elif !defined(ARDUINO) && (__has_include(<SDL2/SDL.h>) || __has_include(<SDL.h>))
-    xGuiMutex = SDL_CreateMutex();
+    xGuiMutex     = SDL_CreateMutex();
+    lvgl_wake_sem = SDL_CreateSemaphore(0);
     SDL_AddTimer(10, lvgl_tick_timer, NULL);
-    SDL_CreateThread(lvgl_sdl_thread, "lvgl_sdl_thread", NULL);
+    app_task_start(APP_TASK_LVGL, lvgl_sdl_thread, NULL);
 #endif
 }
 #elif LVGL_USE_V9 == 1
-static void lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+// Set when two DMA-capable draw buffers were allocated: flushes start a DMA transfer and
+// return at once, so LVGL renders into the other buffer while the previous one is sent.
+// The SPI transaction stays open for the whole refresh and is closed on LV_EVENT_REFR_READY.
+static bool flush_async = false;
+
+// Send one run of changed tiles. A run narrower than the flushed area is not contiguous in
+// the draw buffer: open one window for the whole run and stream its rows into it, instead of
+// addressing the panel again for every row
+static void lvgl_push_run(M5GFX &gfx, int x, int y, int run_w, int run_h, const uint16_t *first, int stride,
+                          bool use_dma)
 {
-    M5GFX &gfx = *(M5GFX *)lv_display_get_driver_data(disp);
+    if (run_w == stride) {
+        if (use_dma) {
+            gfx.pushImageDMA(x, y, run_w, run_h, first);
+        } else {
+            gfx.pushImage(x, y, run_w, run_h, first);
+        }
+        return;
+    }
+    gfx.setAddrWindow(x, y, run_w, run_h);
+    for (int row = 0; row < run_h; row++) {
+        const lgfx::rgb565_t *src = (const lgfx::rgb565_t *)(first + row * stride);
+        if (use_dma) {
+            gfx.writePixelsDMA(src, run_w);
+        } else {
+            gfx.writePixels(src, run_w);
+        }
+    }
+}
 
-    uint32_t w      = (area->x2 - area->x1 + 1);
-    uint32_t h      = (area->y2 - area->y1 + 1);
-    uint32_t pixels = w * h;
+static void lvgl_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    M5GFX &gfx        = *(M5GFX *)lv_display_get_driver_data(disp);
+    uint32_t start_us = app_clock_micros();
 
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-    static uint32_t flush_count = 0;
-    if (flush_count < 5) {
-        Serial.printf("Flush #%d: area(%d,%d)-(%d,%d) size=%dx%d pixels=%d px_map=%p\n", 
-                     flush_count, area->x1, area->y1, area->x2, area->y2, w, h, pixels, px_map);
-        
-        // 最初の数ピクセルのデータをダンプ
-        uint16_t* data = (uint16_t*)px_map;
-        Serial.printf("  First pixels: 0x%04x 0x%04x 0x%04x 0x%04x\n", 
-                     data[0], data[1], data[2], data[3]);
-        flush_count++;
+    if (flush_async) {
+        if (0 == gfx.getStartCount()) {
+            gfx.startWrite();
+        }
+        // A DMA push waits for the previous transfer, so the buffer handed back to LVGL is free.
+        // The transfer time is counted when the last transfer of the frame completes (lvgl_refr_ready_cb)
+        tile_cache.flush((const uint16_t *)px_map, area->x1, area->y1, area->x2, area->y2,
+                         [&gfx](int x, int y, int run_w, int run_h, const uint16_t *first, int stride) {
+                             lvgl_push_run(gfx, x, y, run_w, run_h, first, stride, true);
+                         });
+        perf_stats.flushQueued(lv_area_get_size(area), start_us, app_clock_micros() - start_us);
+        lv_display_flush_ready(disp);
+        return;
     }
-#endif
 
     // M5GFXに直接pushImageを使用（より確実）
-    gfx.pushImage(area->x1, area->y1, w, h, (uint16_t*)px_map);
+    // 前回と同じ内容のタイルは転送しない（変化した範囲だけ pushImage）
+    gfx.startWrite();
+    tile_cache.flush((const uint16_t *)px_map, area->x1, area->y1, area->x2, area->y2,
+                     [&gfx](int x, int y, int run_w, int run_h, const uint16_t *first, int stride) {
+                         lvgl_push_run(gfx, x, y, run_w, run_h, first, stride, false);
+                     });
+    gfx.endWrite();
 
+    perf_stats.flushDone(lv_area_get_size(area), app_clock_micros() - start_us);
     lv_display_flush_ready(disp);
 }
 
+#if defined(ARDUINO) && defined(ESP_PLATFORM) && !defined(BOARD_HAS_PSRAM)
+static void lvgl_refr_ready_cb(lv_event_t *e)
+{
+    M5GFX &gfx = *(M5GFX *)lv_display_get_driver_data((lv_display_t *)lv_event_get_current_target(e));
+    if (0 < gfx.getStartCount()) {
+        gfx.endWrite();  // waits for the last DMA transfer of the frame
+        perf_stats.transferDone(app_clock_micros());
+    }
+}
+#endif
+
 static void lvgl_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
 {
     M5GFX &gfx = *(M5GFX *)lv_indev_get_driver_data(indev);
@@ -230,6 +513,7 @@ static void lvgl_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
 void lvgl_port_init(M5GFX &gfx)
 {
     lv_init();
+    lv_tick_set_cb(app_clock_millis);
 
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
     Serial.printf("LVGL init: screen %dx%d\n", gfx.width(), gfx.height());
@@ -246,6 +530,7 @@ void lvgl_port_init(M5GFX &gfx)
 
     lv_display_set_driver_data(disp, &gfx);
     lv_display_set_flush_cb(disp, lvgl_flush_cb);
+    lvgl_display_hooks_init(disp);
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
 #if defined(BOARD_HAS_PSRAM)
     size_t buf_size = gfx.width() * LV_BUFFER_LINE * sizeof(lv_color_t);
@@ -255,14 +540,33 @@ void lvgl_port_init(M5GFX &gfx)
     lv_display_set_buffers(disp, (void *)buf1, (void *)buf2, buf_size,
                            LV_DISPLAY_RENDER_MODE_PARTIAL);
 #else
-    size_t buf_size = gfx.width() * LV_BUFFER_LINE * sizeof(lv_color_t);
-    static uint8_t *buf1 = (uint8_t *)malloc(buf_size);
-    Serial.printf("LVGL buffer (RAM): %d bytes, ptr=%p\n", buf_size, buf1);
+    const uint32_t caps = MALLOC_CAP_DMA | MALLOC_CAP_8BIT;
+    size_t free_bytes   = heap_caps_get_free_size(caps);
+    size_t largest      = heap_caps_get_largest_free_block(caps);
+    LvglBufferPlan plan = lvgl_plan_draw_buffers(gfx.width(), gfx.height(), LV_COLOR_DEPTH / 8, free_bytes, largest,
+                                                 LVGL_PORT_HEAP_HEADROOM, LVGL_PORT_BUFFER_MIN_LINES, LV_BUFFER_LINE);
+    if (0 == plan.count) {
+        // Not even the minimum fits within the headroom: take it anyway, the display must work
+        plan.lines = LVGL_PORT_BUFFER_MIN_LINES;
+        plan.count = 1;
+        plan.bytes = (size_t)gfx.width() * plan.lines * (LV_COLOR_DEPTH / 8);
+        Serial.println("WARNING: LVGL buffer exceeds the heap headroom");
+    }
+
+    static uint8_t *buf1 = (uint8_t *)heap_caps_malloc(plan.bytes, caps);
+    static uint8_t *buf2 = (2 == plan.count) ? (uint8_t *)heap_caps_malloc(plan.bytes, caps) : NULL;
     if (!buf1) {
         Serial.println("ERROR: Failed to allocate buffer!");
         return;
     }
-    lv_display_set_buffers(disp, (void *)buf1, NULL, buf_size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    Serial.printf("LVGL buffers (DMA RAM): %u x %lu lines (%u bytes each), free %u, largest %u, headroom %u\n",
+                  (unsigned)(buf2 ? 2 : 1), (unsigned long)plan.lines, (unsigned)plan.bytes, (unsigned)free_bytes,
+                  (unsigned)largest, (unsigned)LVGL_PORT_HEAP_HEADROOM);
+    lv_display_set_buffers(disp, (void *)buf1, (void *)buf2, plan.bytes, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    if (buf2) {
+        flush_async = true;
+        lv_display_add_event_cb(disp, lvgl_refr_ready_cb, LV_EVENT_REFR_READY, NULL);
+    }
 #endif
     Serial.println("LVGL display initialized");
 #elif !defined(ARDUINO) && (__has_include(<SDL2/SDL.h>) || __has_include(<SDL.h>))
@@ -297,28 +601,30 @@ void lvgl_port_init(M5GFX &gfx)
     lv_display_set_buffers(disp, (void *)buf1, (void *)buf2, buf_bytes, LV_DISPLAY_RENDER_MODE_PARTIAL);
 #endif
 
-    static lv_indev_t *indev = lv_indev_create();
-    LV_ASSERT_MALLOC(indev);
-    if (indev == NULL) {
-        LV_LOG_ERROR("lv_indev_create failed");
-        return;
+    // Pointer input only when the panel has a touch controller (StickC Plus2 has none, so
+    // getTouch() is not polled every read period; buttons are registered by the app as a keypad)
+    if (gfx.touch()) {
+        lv_indev_t *indev = lv_indev_create();
+        LV_ASSERT_MALLOC(indev);
+        if (indev == NULL) {
+            LV_LOG_ERROR("lv_indev_create failed");
+            return;
+        }
+        lv_indev_set_driver_data(indev, &gfx);
+        lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
+        lv_indev_set_read_cb(indev, lvgl_read_cb);
+        lv_indev_set_display(indev, disp);
     }
-    lv_indev_set_driver_data(indev, &gfx);
-    lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
-    lv_indev_set_read_cb(indev, lvgl_read_cb);
-    lv_indev_set_display(indev, disp);
 
+    // The tick comes from app_clock_millis() (no periodic tick interrupt), so the LVGL task
+    // can sleep as long as lv_timer_handler() allows
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
-    xGuiSemaphore                                     = xSemaphoreCreateMutex();
-    const esp_timer_create_args_t periodic_timer_args = {.callback = &lvgl_tick_timer, .name = "lvgl_tick_timer"};
-    esp_timer_handle_t periodic_timer;
-    ESP_ERROR_CHECK(esp_timer_create(&periodic_timer_args, &periodic_timer));
-    ESP_ERROR_CHECK(esp_timer_start_periodic(periodic_timer, 10 * 1000));
-    xTaskCreate(lvgl_rtos_task, "lvgl_rtos_task", 4096, NULL, 1, NULL);
+    xGuiSemaphore = xSemaphoreCreateMutex();
+    app_task_start(APP_TASK_LVGL, lvgl_rtos_task, NULL);  // core/priority from APP_TASK_PLAN
 #elif !defined(ARDUINO) && (__has_include(<SDL2/SDL.h>) || __has_include(<SDL.h>))
-    xGuiMutex = SDL_CreateMutex();
-    SDL_AddTimer(10, lvgl_tick_timer, NULL);
-    SDL_CreateThread(lvgl_sdl_thread, "lvgl_sdl_thread", NULL);
+    xGuiMutex     = SDL_CreateMutex();
+    lvgl_wake_sem = SDL_CreateSemaphore(0);
+    app_task_start(APP_TASK_LVGL, lvgl_sdl_thread, NULL);
 #endif
 }
 #endif
@@ -327,17 +633,110 @@ bool lvgl_port_lock(void)
 {
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
     return xSemaphoreTake(xGuiSemaphore, portMAX_DELAY) == pdTRUE ? true : false;
+#elif defined(EMULATOR_HEADLESS)
+    return true;
 #elif !defined(ARDUINO) && (__has_include(<SDL2/SDL.h>) || __has_include(<SDL.h>))
     return SDL_LockMutex(xGuiMutex) == 0 ? true : false;
 #endif
 }
 
+// Wakes the LVGL task when the caller invalidated something, so a sleeping (idle rate)
+// governor redraws right away instead of at its next idle period
 void lvgl_port_unlock(void)
 {
+    bool wake = invalidate_pending;
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
     xSemaphoreGive(xGuiSemaphore);
+    if (wake && lvgl_task_handle) {
+        xTaskNotifyGive(lvgl_task_handle);
+    }
+#elif defined(EMULATOR_HEADLESS)
+    (void)wake;
 #elif !defined(ARDUINO) && (__has_include(<SDL2/SDL.h>) || __has_include(<SDL.h>))
     SDL_UnlockMutex(xGuiMutex);
+    if (wake) {
+        SDL_SemPost(lvgl_wake_sem);
+    }
+#endif
+}
+
+void lvgl_port_get_flush_stats(lvgl_port_flush_stats_t *stats)
+{
+    const TileCache::Stats &s = tile_cache.getStats();
+    stats->flushes            = s.flushes;
+    stats->tiles_pushed       = s.tiles_pushed;
+    stats->tiles_skipped      = s.tiles_skipped;
+    stats->bytes_pushed       = s.bytes_pushed;
+    stats->bytes_skipped      = s.bytes_skipped;
+}
+
+void lvgl_port_print_flush_stats(void)
+{
+    lvgl_port_flush_stats_t stats;
+    lvgl_port_get_flush_stats(&stats);
+    uint64_t total = stats.bytes_pushed + stats.bytes_skipped;
+    unsigned saved = (0 < total) ? (unsigned)(stats.bytes_skipped * 100 / total) : 0;
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+    Serial.printf("Flush: %lu flushes, pushed %llu bytes (%lu tiles), skipped %llu bytes (%lu tiles), %u%% saved\n",
+                  (unsigned long)stats.flushes, (unsigned long long)stats.bytes_pushed,
+                  (unsigned long)stats.tiles_pushed, (unsigned long long)stats.bytes_skipped,
+                  (unsigned long)stats.tiles_skipped, saved);
+#else
+    printf("Flush: %lu flushes, pushed %llu bytes (%lu tiles), skipped %llu bytes (%lu tiles), %u%% saved\n",
+           (unsigned long)stats.flushes, (unsigned long long)stats.bytes_pushed, (unsigned long)stats.tiles_pushed,
+           (unsigned long long)stats.bytes_skipped, (unsigned long)stats.tiles_skipped, saved);
+#endif
+}
+
+void lvgl_port_get_perf(lvgl_port_perf_t *perf)
+{
+    *perf = perf_last;
+}
+
+void lvgl_port_print_perf_json(void)
+{
+    const lvgl_port_perf_t &p = perf_last;
+    const TileCache::Stats &s = tile_cache.getStats();
+    char line[384];
+    snprintf(line, sizeof(line),
+             "{\"perf\":{\"t\":%lu,\"window_ms\":%lu,\"frames\":%lu,\"fps\":%lu.%lu,"
+             "\"render_us\":{\"avg\":%lu,\"max\":%lu},\"flush_us\":{\"avg\":%lu,\"max\":%lu},\"flushes\":%lu,"
+             "\"area_hist\":[%lu,%lu,%lu,%lu,%lu],"
+             "\"heap\":{\"total\":%lu,\"free\":%lu,\"biggest\":%lu,\"max_used\":%lu,\"used_pct\":%u,\"frag_pct\":%u},"
+             "\"bytes\":{\"pushed\":%llu,\"skipped\":%llu}}}",
+             (unsigned long)app_clock_millis(), (unsigned long)p.window_ms, (unsigned long)p.frames,
+             (unsigned long)(p.fps_x10 / 10), (unsigned long)(p.fps_x10 % 10), (unsigned long)p.render_us_avg,
+             (unsigned long)p.render_us_max, (unsigned long)p.flush_us_avg, (unsigned long)p.flush_us_max,
+             (unsigned long)p.flushes, (unsigned long)p.area_hist[0], (unsigned long)p.area_hist[1],
+             (unsigned long)p.area_hist[2], (unsigned long)p.area_hist[3], (unsigned long)p.area_hist[4],
+             (unsigned long)p.heap_total, (unsigned long)p.heap_free, (unsigned long)p.heap_free_biggest,
+             (unsigned long)p.heap_max_used, (unsigned)p.heap_used_pct, (unsigned)p.heap_frag_pct,
+             (unsigned long long)s.bytes_pushed, (unsigned long long)s.bytes_skipped);
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+    Serial.println(line);
+#else
+    printf("%s\n", line);
+#endif
+}
+
+void lvgl_port_perf_overlay_toggle(void)
+{
+#if LVGL_USE_V9 == 1
+    if (perf_overlay == NULL) {
+        perf_overlay = lv_label_create(lv_layer_top());
+        lv_obj_set_style_text_font(perf_overlay, &lv_font_montserrat_14, 0);
+        lv_obj_set_style_text_color(perf_overlay, lv_color_white(), 0);
+        lv_obj_set_style_bg_color(perf_overlay, lv_color_black(), 0);
+        lv_obj_set_style_bg_opa(perf_overlay, LV_OPA_70, 0);
+        lv_obj_set_style_pad_all(perf_overlay, 2, 0);
+        lv_obj_align(perf_overlay, LV_ALIGN_TOP_LEFT, 0, 0);
+        lvgl_perf_overlay_update();
+    } else if (lv_obj_has_flag(perf_overlay, LV_OBJ_FLAG_HIDDEN)) {
+        lv_obj_remove_flag(perf_overlay, LV_OBJ_FLAG_HIDDEN);
+        lvgl_perf_overlay_update();
+    } else {
+        lv_obj_add_flag(perf_overlay, LV_OBJ_FLAG_HIDDEN);
+    }
 #endif
 }
 
@@ -4,17 +4,69 @@
 #if defined(ARDUINO)
 #include <Arduino.h>
 #endif
+#if !defined(EMULATOR_HEADLESS)
 #include <M5GFX.h>
+#endif
 #include "lvgl.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#if defined(EMULATOR_HEADLESS)
+void lvgl_port_init(void);
+void lvgl_port_run(void);  // LVGLタイマー処理（ヘッドレスはメインループから呼ぶ）
+#else
 void lvgl_port_init(M5GFX &gfx);
+#endif
 bool lvgl_port_lock(void);
 void lvgl_port_unlock(void);
 
+/**
+ * @brief フラッシュ転送の統計（タイル差分で省略した分を含む）
+ */
+typedef struct {
+    uint32_t flushes;        // フラッシュ回数
+    uint32_t tiles_pushed;   // 転送したタイル数
+    uint32_t tiles_skipped;  // 内容が同じで省略したタイル数
+    uint64_t bytes_pushed;   // 転送したバイト数
+    uint64_t bytes_skipped;  // 省略したバイト数
+} lvgl_port_flush_stats_t;
+
+void lvgl_port_get_flush_stats(lvgl_port_flush_stats_t *stats);
+void lvgl_port_print_flush_stats(void);
+
+#define LVGL_PORT_PERF_AREA_BINS 5
+
+/**
+ * @brief 描画性能（直近の集計窓、LVGL_PORT_PERF_WINDOW_MS ごとに更新）
+ */
+typedef struct {
+    uint32_t window_ms;                            // 集計窓の長さ
+    uint32_t frames;                               // 描画したフレーム数
+    uint32_t fps_x10;                              // フレームレート x10
+    uint32_t render_us_avg;                        // 1フレームの描画時間（フラッシュを除く）
+    uint32_t render_us_max;                        //
+    uint32_t flush_us_avg;                         // 1フレームのフラッシュ時間
+    uint32_t flush_us_max;                         //
+    uint32_t flushes;                              // フラッシュ回数
+    uint32_t area_hist[LVGL_PORT_PERF_AREA_BINS];  // フラッシュ面積 <=256, <=1024, <=4096, <=16384, それ以上 [px]
+    uint32_t heap_total;                           // LVGLヒープ [byte]
+    uint32_t heap_free;                            //
+    uint32_t heap_free_biggest;                    // 最大の空きブロック
+    uint32_t heap_max_used;                        // 起動後の最大使用量
+    uint8_t heap_used_pct;                         // 使用率 [%]
+    uint8_t heap_frag_pct;                         // 断片化率 [%]
+} lvgl_port_perf_t;
+
+void lvgl_port_get_perf(lvgl_port_perf_t *perf);
+void lvgl_port_print_perf_json(void);
+
+/**
+ * @brief 画面上部に描画性能のオーバーレイを表示/非表示（lvgl_port_lock() 中に呼ぶこと）
+ */
+void lvgl_port_perf_overlay_toggle(void);
+
 #ifdef __cplusplus
 }
 #endif
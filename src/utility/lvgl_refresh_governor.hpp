@@ -0,0 +1,64 @@
+#ifndef __LVGL_REFRESH_GOVERNOR_HPP__
+#define __LVGL_REFRESH_GOVERNOR_HPP__
+
+#include <stdint.h>
+
+/**
+ * @brief LVGLの画面更新周期の調整（入力デバイスの読み取り周期は変えない）
+ * 画面の無効化（描画要求）があってから hold_ms の間は active_period で更新し、
+ * それ以外は idle_period まで更新周期を落とす。
+ * LVGLタスクは lv_timer_handler() の戻り値（次のタイマーまでの時間）だけ待機する。
+ */
+class RefreshGovernor {
+public:
+    RefreshGovernor(uint32_t active_period, uint32_t idle_period, uint32_t hold_ms)
+        : active_period(active_period), idle_period(idle_period), hold_ms(hold_ms), last_activity_ms(0), active(true)
+    {
+    }
+
+    /**
+     * @brief 描画要求があったことを記録
+     */
+    void markActivity(uint32_t now_ms)
+    {
+        last_activity_ms = now_ms;
+        active           = true;
+    }
+
+    /**
+     * @brief 現在の更新周期 [ms]
+     */
+    uint32_t refreshPeriod(uint32_t now_ms)
+    {
+        if (active && hold_ms <= now_ms - last_activity_ms) {
+            active = false;
+        }
+        return active ? active_period : idle_period;
+    }
+
+    bool isActive(void) const
+    {
+        return active;
+    }
+
+    /**
+     * @brief 次に起きるまでの待機時間 [ms]
+     * @param until_next_timer lv_timer_handler() の戻り値（タイマーなしは UINT32_MAX）
+     */
+    uint32_t sleepMs(uint32_t until_next_timer) const
+    {
+        if (idle_period < until_next_timer) {
+            return idle_period;
+        }
+        return (0 < until_next_timer) ? until_next_timer : 1;
+    }
+
+private:
+    uint32_t active_period;
+    uint32_t idle_period;
+    uint32_t hold_ms;
+    uint32_t last_activity_ms;
+    bool active;
+};
+
+#endif  // __LVGL_REFRESH_GOVERNOR_HPP__
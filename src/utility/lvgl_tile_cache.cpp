@@ -0,0 +1,47 @@
+#include "lvgl_tile_cache.hpp"
+
+#include <string.h>
+
+void TileCache::begin(int width, int height, bool enable)
+{
+    cols    = (width + TILE - 1) / TILE;
+    rows    = (height + TILE - 1) / TILE;
+    enabled = enable && (0 < cols && 0 < rows && cols * rows <= MAX_TILES);
+    memset(&stats, 0, sizeof(stats));
+    invalidate();
+}
+
+void TileCache::invalidate(void)
+{
+    // 0 はハッシュ値として使わない（必ず不一致になる）
+    memset(hashes, 0, sizeof(hashes));
+}
+
+void TileCache::alignArea(int32_t* x1, int32_t* y1, int32_t* x2, int32_t* y2, int width, int height)
+{
+    *x1 = *x1 / TILE * TILE;
+    *y1 = *y1 / TILE * TILE;
+    *x2 = *x2 / TILE * TILE + TILE - 1;
+    *y2 = *y2 / TILE * TILE + TILE - 1;
+    if (width <= *x2) {
+        *x2 = width - 1;
+    }
+    if (height <= *y2) {
+        *y2 = height - 1;
+    }
+}
+
+uint32_t TileCache::hashRegion(const uint16_t* first, int stride, int x, int y, int w, int h)
+{
+    // FNV-1a（16bit単位）、領域の座標から開始
+    uint32_t hash = 2166136261u;
+    hash          = (hash ^ (uint32_t)(x | (y << 16))) * 16777619u;
+    hash          = (hash ^ (uint32_t)(w | (h << 16))) * 16777619u;
+    for (int row = 0; row < h; row++) {
+        const uint16_t* p = first + row * stride;
+        for (int col = 0; col < w; col++) {
+            hash = (hash ^ p[col]) * 16777619u;
+        }
+    }
+    return (0 == hash) ? 1 : hash;
+}
@@ -0,0 +1,133 @@
+#ifndef __LVGL_TILE_CACHE_HPP__
+#define __LVGL_TILE_CACHE_HPP__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief フラッシュ領域の差分検出（タイルハッシュキャッシュ）
+ * 画面を TILE x TILE ピクセルのタイルに分け、前回転送した内容のハッシュを保持する。
+ * フラッシュ時に内容が変わっていないタイルは転送を省略し、
+ * 変化したタイルを横方向に連続する範囲ごとに push コールバックへ渡す。
+ * ハッシュには領域の座標も含めるため、タイルの一部だけが描画された場合でも
+ * 同じ範囲・同じ内容のときだけ省略される。
+ */
+class TileCache {
+public:
+    static const int TILE      = 16;   // タイルの1辺 [px]
+    static const int MAX_TILES = 300;  // 320x240 まで対応
+
+    struct Stats {
+        uint32_t flushes;        // フラッシュ回数
+        uint32_t tiles_pushed;   // 転送したタイル数（部分タイル含む）
+        uint32_t tiles_skipped;  // 省略したタイル数
+        uint64_t bytes_pushed;   // 転送したバイト数
+        uint64_t bytes_skipped;  // 省略したバイト数
+    };
+
+    TileCache() : cols(0), rows(0), enabled(false), stats()
+    {
+    }
+
+    /**
+     * @brief 画面サイズを設定
+     * 無効時、またはタイル数が MAX_TILES を超える場合は常に全体を転送する（統計のみ取る）
+     */
+    void begin(int width, int height, bool enable = true);
+
+    /**
+     * @brief キャッシュを破棄（次回はすべて転送）
+     */
+    void invalidate(void);
+
+    bool isEnabled(void) const
+    {
+        return enabled;
+    }
+
+    const Stats& getStats(void) const
+    {
+        return stats;
+    }
+
+    /**
+     * @brief 領域の外側をタイル境界に揃える（LV_EVENT_INVALIDATE_AREA で使用）
+     */
+    static void alignArea(int32_t* x1, int32_t* y1, int32_t* x2, int32_t* y2, int width, int height);
+
+    /**
+     * @brief フラッシュ領域を差分転送
+     * @param px 領域のピクセル（RGB565、幅 x2-x1+1 で連続）
+     * @param push 転送関数 push(x, y, w, h, const uint16_t* first, int stride)
+     *             first は (x, y) のピクセル、stride は1行のピクセル数
+     */
+    template <typename PushFn>
+    void flush(const uint16_t* px, int x1, int y1, int x2, int y2, PushFn&& push);
+
+private:
+    int cols;
+    int rows;
+    bool enabled;
+    Stats stats;
+    uint32_t hashes[MAX_TILES];
+
+    static uint32_t hashRegion(const uint16_t* first, int stride, int x, int y, int w, int h);
+};
+
+template <typename PushFn>
+void TileCache::flush(const uint16_t* px, int x1, int y1, int x2, int y2, PushFn&& push)
+{
+    int w = x2 - x1 + 1;
+    int h = y2 - y1 + 1;
+    stats.flushes++;
+
+    if (!enabled) {
+        push(x1, y1, w, h, px, w);
+        stats.bytes_pushed += (uint64_t)w * h * 2;
+        return;
+    }
+
+    for (int ty = y1 / TILE; ty <= y2 / TILE; ty++) {
+        int by1 = (ty * TILE < y1) ? y1 : ty * TILE;
+        int by2 = (ty * TILE + TILE - 1 > y2) ? y2 : ty * TILE + TILE - 1;
+        int bh  = by2 - by1 + 1;
+
+        // 変化したタイルが連続する範囲 [run_x1, run_x2] をまとめて転送
+        int run_x1 = -1;
+        int run_x2 = -1;
+        for (int tx = x1 / TILE; tx <= x2 / TILE + 1; tx++) {
+            bool changed = false;
+            int rx1 = 0;
+            int rx2 = 0;
+            if (tx <= x2 / TILE) {
+                rx1                  = (tx * TILE < x1) ? x1 : tx * TILE;
+                rx2                  = (tx * TILE + TILE - 1 > x2) ? x2 : tx * TILE + TILE - 1;
+                const uint16_t* tile = px + (by1 - y1) * w + (rx1 - x1);
+                uint32_t hash        = hashRegion(tile, w, rx1, by1, rx2 - rx1 + 1, bh);
+                uint32_t& cached     = hashes[ty * cols + tx];
+                uint32_t bytes       = (uint32_t)(rx2 - rx1 + 1) * bh * 2;
+                changed              = (cached != hash);
+                cached               = hash;
+                if (changed) {
+                    stats.tiles_pushed++;
+                    stats.bytes_pushed += bytes;
+                } else {
+                    stats.tiles_skipped++;
+                    stats.bytes_skipped += bytes;
+                }
+            }
+
+            if (changed) {
+                if (run_x1 < 0) {
+                    run_x1 = rx1;
+                }
+                run_x2 = rx2;
+            } else if (0 <= run_x1) {
+                push(run_x1, by1, run_x2 - run_x1 + 1, bh, px + (by1 - y1) * w + (run_x1 - x1), w);
+                run_x1 = -1;
+            }
+        }
+    }
+}
+
+#endif  // __LVGL_TILE_CACHE_HPP__
@@ -1,78 +1,159 @@
 #include "qrcode_generator.hpp"
 #include <string.h>
 
-// qrcode.cライブラリを使用（PlatformIOでインストール必要）
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
+// qrcode.cライブラリを使用（PlatformIOでインストール必要、実機・エミュレーター共通）
 #include "qrcode.h"
-#endif
 
 #include "lvgl.h"
 
-bool QRCodeGenerator::generate(const char* text, uint8_t& outSize, uint8_t qrcode[MAX_SIZE][MAX_SIZE])
+// バイトモード・誤り訂正L の最大バイト数（バージョン1〜10）
+static const uint16_t BYTE_CAPACITY_L[QRCodeGenerator::MAX_VERSION] = {17, 32, 53, 78, 106, 134, 154, 192, 230, 271};
+
+uint8_t QRCodeGenerator::selectVersion(size_t length)
+{
+    for (uint8_t v = 1; v <= MAX_VERSION; v++) {
+        if (length <= BYTE_CAPACITY_L[v - 1]) {
+            return v;
+        }
+    }
+    return 0;
+}
+
+bool QRCodeGenerator::generate(const char* text, Matrix& qrcode)
 {
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-    // qrcode.cライブラリを使用
+    uint8_t version = selectVersion(strlen(text));
+    qrcode.version  = 0;
+    if (0 == version) {
+        return false;
+    }
+
+    // qrcode.cライブラリを使用（ビット配置が同じため modules へ直接生成）
+    // qrcode_getBufferSize(MAX_VERSION) == MATRIX_BYTES
     QRCode qr;
-    uint8_t qrcodeBytes[qrcode_getBufferSize(3)];
-    
-    int result = qrcode_initText(&qr, qrcodeBytes, 3, ECC_LOW, text);
-    
+    int result = qrcode_initText(&qr, qrcode.modules, version, ECC_LOW, text);
+
     if (result != 0) {
         return false;
     }
-    
-    outSize = qr.size;
-    
-    // データをコピー
-    for (uint8_t y = 0; y < qr.size; y++) {
-        for (uint8_t x = 0; x < qr.size; x++) {
-            qrcode[y][x] = qrcode_getModule(&qr, x, y) ? 1 : 0;
-        }
-    }
-    
+
+    qrcode.version = version;
+    qrcode.size    = qr.size;
     return true;
-#else
-    // エミュレーター環境：ダミーQRコード（市松模様）
-    outSize = 21;  // QRコードバージョン1のサイズ
-    
-    for (uint8_t y = 0; y < outSize; y++) {
-        for (uint8_t x = 0; x < outSize; x++) {
-            // 市松模様パターン
-            qrcode[y][x] = ((x + y) % 2 == 0) ? 1 : 0;
-        }
-    }
-    
-    // 位置検出パターン風の模様を追加（左上、右上、左下）
-    for (int i = 0; i < 7; i++) {
-        for (int j = 0; j < 7; j++) {
-            bool isEdge = (i == 0 || i == 6 || j == 0 || j == 6);
-            bool isCenter = (i >= 2 && i <= 4 && j >= 2 && j <= 4);
-            uint8_t val = (isEdge || isCenter) ? 1 : 0;
-            
-            qrcode[i][j] = val;  // 左上
-            qrcode[i][outSize - 1 - j] = val;  // 右上
-            qrcode[outSize - 1 - i][j] = val;  // 左下
+}
+
+// 1行分のピクセル（モジュールを scale 倍に展開）を書き込む
+static void rasterizeRow(uint8_t* row, lv_color_format_t cf, uint32_t stride, uint32_t width,
+                         const QRCodeGenerator::Matrix* qrcode, uint8_t my, uint8_t scale, uint8_t margin)
+{
+    // qrcode が nullptr の場合は余白行（モジュールなし）
+    uint8_t size = qrcode ? qrcode->size : 0;
+    switch (cf) {
+        case LV_COLOR_FORMAT_I1:
+            memset(row, 0, stride);
+            for (uint8_t x = 0; x < size; x++) {
+                if (qrcode->get(x, my)) {
+                    uint32_t px = margin + x * scale;
+                    for (uint8_t sx = 0; sx < scale && px < width; sx++, px++) {
+                        row[px >> 3] |= (uint8_t)(0x80 >> (px & 7));
+                    }
+                }
+            }
+            break;
+        case LV_COLOR_FORMAT_A8:
+            memset(row, 0, stride);
+            for (uint8_t x = 0; x < size; x++) {
+                uint32_t px = margin + x * scale;
+                if (qrcode->get(x, my) && px < width) {
+                    memset(row + px, 0xFF, (px + scale <= width) ? scale : width - px);
+                }
+            }
+            break;
+        case LV_COLOR_FORMAT_RGB565: {
+            uint16_t* pixels = (uint16_t*)row;
+            uint16_t white   = lv_color_to_u16(lv_color_white());
+            uint16_t black   = lv_color_to_u16(lv_color_black());
+            for (uint32_t px = 0; px < width; px++) {
+                pixels[px] = white;
+            }
+            for (uint8_t x = 0; x < size; x++) {
+                if (qrcode->get(x, my)) {
+                    uint32_t px = margin + x * scale;
+                    for (uint8_t sx = 0; sx < scale && px < width; sx++, px++) {
+                        pixels[px] = black;
+                    }
+                }
+            }
+            break;
         }
+        default:
+            break;
     }
-    
-    return true;
-#endif
 }
 
-void QRCodeGenerator::drawToCanvas(void* canvas, uint8_t qrcode[MAX_SIZE][MAX_SIZE], uint8_t size, uint8_t scale)
+void QRCodeGenerator::drawToCanvas(void* canvas, const Matrix& qrcode, uint8_t scale, uint8_t margin)
 {
-    lv_obj_t* canvasObj = (lv_obj_t*)canvas;
-    
-    for (uint8_t y = 0; y < size; y++) {
-        for (uint8_t x = 0; x < size; x++) {
-            lv_color_t color = qrcode[y][x] ? lv_color_black() : lv_color_white();
-            
-            // スケール分のピクセルを塗りつぶす
-            for (uint8_t sy = 0; sy < scale; sy++) {
-                for (uint8_t sx = 0; sx < scale; sx++) {
-                    lv_canvas_set_px(canvasObj, x * scale + sx, y * scale + sy, color, LV_OPA_COVER);
+    uint8_t size            = qrcode.size;
+    lv_obj_t* canvasObj     = (lv_obj_t*)canvas;
+    lv_draw_buf_t* draw_buf = lv_canvas_get_draw_buf(canvasObj);
+    lv_color_format_t cf    = (lv_color_format_t)draw_buf->header.cf;
+    uint32_t width          = draw_buf->header.w;
+    uint32_t height         = draw_buf->header.h;
+    uint32_t stride         = draw_buf->header.stride;
+
+    if (cf != LV_COLOR_FORMAT_I1 && cf != LV_COLOR_FORMAT_A8 && cf != LV_COLOR_FORMAT_RGB565) {
+        // 未対応形式：1ピクセルずつ描画
+        lv_canvas_fill_bg(canvasObj, lv_color_white(), LV_OPA_COVER);
+        for (uint8_t y = 0; y < size; y++) {
+            for (uint8_t x = 0; x < size; x++) {
+                lv_color_t color = qrcode.get(x, y) ? lv_color_black() : lv_color_white();
+                for (uint8_t sy = 0; sy < scale; sy++) {
+                    for (uint8_t sx = 0; sx < scale; sx++) {
+                        lv_canvas_set_px(canvasObj, margin + x * scale + sx, margin + y * scale + sy, color,
+                                         LV_OPA_COVER);
+                    }
                 }
             }
         }
+        return;
     }
+
+    if (cf == LV_COLOR_FORMAT_I1) {
+        lv_canvas_set_palette(canvasObj, 0, lv_color32_make(0xFF, 0xFF, 0xFF, 0xFF));
+        lv_canvas_set_palette(canvasObj, 1, lv_color32_make(0x00, 0x00, 0x00, 0xFF));
+    }
+
+    // 余白行（モジュールなし）を1行作り、上下の余白へ複製
+    uint8_t* blank_row = nullptr;
+    uint32_t y = 0;
+    for (; y < margin && y < height; y++) {
+        uint8_t* row = (uint8_t*)lv_draw_buf_goto_xy(draw_buf, 0, y);
+        if (blank_row) {
+            memcpy(row, blank_row, stride);
+        } else {
+            rasterizeRow(row, cf, stride, width, nullptr, 0, scale, margin);
+            blank_row = row;
+        }
+    }
+
+    // モジュール行：先頭1行を展開し、残り scale-1 行は複製
+    for (uint8_t my = 0; my < size && y < height; my++) {
+        uint8_t* first = (uint8_t*)lv_draw_buf_goto_xy(draw_buf, 0, y);
+        rasterizeRow(first, cf, stride, width, &qrcode, my, scale, margin);
+        y++;
+        for (uint8_t sy = 1; sy < scale && y < height; sy++, y++) {
+            memcpy(lv_draw_buf_goto_xy(draw_buf, 0, y), first, stride);
+        }
+    }
+
+    for (; y < height; y++) {
+        uint8_t* row = (uint8_t*)lv_draw_buf_goto_xy(draw_buf, 0, y);
+        if (blank_row) {
+            memcpy(row, blank_row, stride);
+        } else {
+            rasterizeRow(row, cf, stride, width, nullptr, 0, scale, margin);
+            blank_row = row;
+        }
+    }
+
+    lv_obj_invalidate(canvasObj);
 }
@@ -1,33 +1,75 @@
 #ifndef __QRCODE_GENERATOR_HPP__
 #define __QRCODE_GENERATOR_HPP__
 
+#include <stddef.h>
 #include <stdint.h>
 
 /**
  * @brief シンプルなQRコード生成クラス
- * LVGLで表示するための2次元配列データを生成
+ * LVGLで表示するためのモジュールデータ（1モジュール1ビット）を生成
+ * 生成・描画ともにヒープを使用しない
  */
 class QRCodeGenerator {
 public:
-    static const int MAX_SIZE = 33;  // QRコードの最大サイズ（バージョン3）
-    
+    static const uint8_t MAX_VERSION = 10;                  // 対応する最大バージョン
+    static const uint8_t MAX_SIZE    = 4 * MAX_VERSION + 17;  // QRコードの最大サイズ（57）
+    static const size_t MATRIX_BYTES = ((size_t)MAX_SIZE * MAX_SIZE + 7) / 8;
+
+    /**
+     * @brief ビットパックしたモジュール行列
+     * ビット配置は qrcode.c と同じ（offset = y * size + x、MSBから）
+     */
+    struct Matrix {
+        uint8_t version;                // バージョン（1〜MAX_VERSION、0=未生成）
+        uint8_t size;                   // 1辺のモジュール数
+        uint8_t modules[MATRIX_BYTES];  // モジュール（1=黒）
+
+        bool get(uint8_t x, uint8_t y) const
+        {
+            uint32_t offset = (uint32_t)y * size + x;
+            return 0 != (modules[offset >> 3] & (0x80 >> (offset & 7)));
+        }
+
+        void set(uint8_t x, uint8_t y, bool dark)
+        {
+            uint32_t offset = (uint32_t)y * size + x;
+            uint8_t mask    = (uint8_t)(0x80 >> (offset & 7));
+            if (dark) {
+                modules[offset >> 3] |= mask;
+            } else {
+                modules[offset >> 3] &= (uint8_t)~mask;
+            }
+        }
+    };
+
+    /**
+     * @brief テキスト長から最小のバージョンを選択（バイトモード・誤り訂正L）
+     * @param length テキストのバイト数
+     * @return バージョン（1〜MAX_VERSION）、収まらない場合は0
+     */
+    static uint8_t selectVersion(size_t length);
+
     /**
      * @brief QRコードを生成
+     * バージョンはテキスト長から自動選択する
      * @param text QRコードにエンコードするテキスト
-     * @param outSize 生成されたQRコードのサイズ（出力）
-     * @param qrcode QRコードデータの出力先（MAX_SIZE x MAX_SIZE配列）
-     * @return 成功した場合true
+     * @param qrcode QRコードデータの出力先
+     * @return 成功した場合true（長すぎる場合false）
      */
-    static bool generate(const char* text, uint8_t& outSize, uint8_t qrcode[MAX_SIZE][MAX_SIZE]);
-    
+    static bool generate(const char* text, Matrix& qrcode);
+
     /**
      * @brief QRコードをLVGLキャンバスに描画
+     * キャンバスのバッファへ1行ずつ直接展開し、同じ行はmemcpyで複製する。
+     * 対応形式: I1（index0=白, index1=黒）、A8（黒モジュール=不透明）、RGB565
+     * それ以外の形式は lv_canvas_set_px で描画する。
+     * キャンバス全体を書き換える（margin 部分は白/透明）。
      * @param canvas LVGLキャンバスオブジェクト
      * @param qrcode QRコードデータ
-     * @param size QRコードのサイズ
      * @param scale 各モジュールのピクセルサイズ
+     * @param margin 左上の余白 [px]
      */
-    static void drawToCanvas(void* canvas, uint8_t qrcode[MAX_SIZE][MAX_SIZE], uint8_t size, uint8_t scale);
+    static void drawToCanvas(void* canvas, const Matrix& qrcode, uint8_t scale, uint8_t margin = 0);
 };
 
 #endif  // __QRCODE_GENERATOR_HPP__
@@ -3,6 +3,8 @@
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
 #include <Wire.h>
 
+#include "button_events.hpp"
+
 // MPU6886 (IMU) registers
 #define MPU6886_ADDRESS     0x68
 #define MPU6886_WHOAMI      0x75
@@ -22,15 +24,39 @@
 #define HX711_SCALE_FACTOR 27.61f
 #endif
 
+// センサートレース記録（1: HX711生カウントとIMUをシリアルへ出力）
+#ifndef SENSOR_TRACE_RECORD
+#define SENSOR_TRACE_RECORD 0
+#endif
+
 // Buttons on M5StickC Plus2
 #define BUTTON_A_PIN         37
 #define BUTTON_B_PIN         39
 
+// ボタンのエッジは割り込みで時刻付けし、デバウンスしてキューに積む
+static const uint8_t BUTTON_PINS[ButtonEvents::MAX_BUTTONS] = {BUTTON_A_PIN, BUTTON_B_PIN};
+static ButtonEvents button_events;
+static portMUX_TYPE button_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static void IRAM_ATTR button_isr(void* arg)
+{
+    uint8_t button = (uint8_t)(uintptr_t)arg;
+    bool level     = digitalRead(BUTTON_PINS[button]) == LOW;
+    uint32_t now   = millis();
+    portENTER_CRITICAL_ISR(&button_mux);
+    button_events.onEdge(button, level, now);
+    portEXIT_CRITICAL_ISR(&button_mux);
+}
+
 RealHardware::RealHardware()
     : current_brightness(128)
     , scale_ready(false)
     , wifi_status(WiFiStatus::DISCONNECTED)
     , wifi_connect_start(0)
+    , btnA_prev(false)
+    , btnB_prev(false)
+    , btnA_was_pressed(false)
+    , btnB_was_pressed(false)
 {
 }
 
@@ -56,7 +82,10 @@ void RealHardware::begin()
     // Button initialization (GPIO)
     pinMode(BUTTON_A_PIN, INPUT_PULLUP);
     pinMode(BUTTON_B_PIN, INPUT_PULLUP);
-    Serial.printf("  Buttons initialized (GPIO %d=A, %d=B)\n", BUTTON_A_PIN, BUTTON_B_PIN);
+    for (uint8_t i = 0; i < ButtonEvents::MAX_BUTTONS; i++) {
+        attachInterruptArg(digitalPinToInterrupt(BUTTON_PINS[i]), button_isr, (void*)(uintptr_t)i, CHANGE);
+    }
+    Serial.printf("  Buttons initialized (GPIO %d=A, %d=B, interrupt)\n", BUTTON_A_PIN, BUTTON_B_PIN);
     
     // IMU initialization (MPU6886)
     Wire.beginTransmission(MPU6886_ADDRESS);
@@ -95,40 +124,121 @@ void RealHardware::begin()
     scale.set_scale(HX711_SCALE_FACTOR);
     scale.tare();
     Serial.printf("  HX711 initialized successfully (DAT=%d CLK=%d)\n", HX711_DOUT_PIN, HX711_SCK_PIN);
+
+#if SENSOR_TRACE_RECORD
+    Serial.println("  Sensor trace recording enabled");
+    recordTraceCalibration();
+#endif
     
     Serial.println("Hardware init completed WITHOUT M5Unified");
 }
 
 void RealHardware::update()
 {
+    // デバウンス期間中に確定したレベル変化（割り込みでは捨てたもの）を補う
+    // レベルと時刻はロック内で読む（外で読むと、その間に割り込みが記録したエッジより古い時刻・レベルで上書きする）
+    for (uint8_t i = 0; i < ButtonEvents::MAX_BUTTONS; i++) {
+        portENTER_CRITICAL(&button_mux);
+        bool level   = digitalRead(BUTTON_PINS[i]) == LOW;
+        uint32_t now = millis();
+        button_events.sync(i, level, now);
+        portEXIT_CRITICAL(&button_mux);
+    }
+
+    // wasPressed検出（立ち上がりエッジ、読み取るまで保持）
+    bool btnA = isButtonAPressed();
+    bool btnB = isButtonBPressed();
+    btnA_was_pressed = btnA_was_pressed || (btnA && !btnA_prev);
+    btnB_was_pressed = btnB_was_pressed || (btnB && !btnB_prev);
+    btnA_prev        = btnA;
+    btnB_prev        = btnB;
 }
 
-bool RealHardware::isButtonAPressed()
+///////////////////////////////////////
+/// @brief HX711の生カウントを times 回読んで平均
+/// HX711ライブラリの read_average() は変換完了を delay(0) で待ち続け、同じ優先度以上にしか譲らない。
+/// 変換（10SPSで約100ms）の完了までは1ティックずつ待ち、同じコアの下位タスク（描画・アプリ）を動かす
+long RealHardware::readScaleAverage(uint8_t times)
 {
-    return digitalRead(BUTTON_A_PIN) == LOW;
+    long sum = 0;
+    for (uint8_t i = 0; i < times; i++) {
+        while (!scale.is_ready()) {
+            vTaskDelay(1);
+        }
+        sum += scale.read();
+    }
+    return sum / times;
 }
 
-bool RealHardware::isButtonBPressed()
+///////////////////////////////////////
+/// @brief 生データを1サンプル記録
+/// 重量の読み出しから呼ぶ（HX711・IMUに触れるのは計測タスクだけにする）
+/// @param raw アプリが重量の計算に使った生カウント（HX711を別に読むと変換を横取りするため）
+void RealHardware::recordTraceSample(int32_t raw)
 {
-    return digitalRead(BUTTON_B_PIN) == LOW;
+    SensorTraceSample sample;
+    sample.time_ms = millis();
+    sample.raw     = raw;
+    getAccel(&sample.accel[0], &sample.accel[1], &sample.accel[2]);
+    getGyro(&sample.gyro[0], &sample.gyro[1], &sample.gyro[2]);
+    sample.buttons = (isButtonAPressed() ? SENSOR_TRACE_BUTTON_A : 0)
+                   | (isButtonBPressed() ? SENSOR_TRACE_BUTTON_B : 0);
+
+    char line[SENSOR_TRACE_LINE_MAX];
+    int len = sensor_trace_format_sample(line, sizeof(line), sample);
+    if (0 < len) {
+        Serial.write((const uint8_t*)line, len);
+    }
 }
 
-bool RealHardware::wasButtonAPressed()
+///////////////////////////////////////
+/// @brief ボタンのエッジを1件記録
+/// アプリが取り出したイベントごとに呼ぶ（重量サンプルの間の短い押下も割り込み時の時刻で残す）
+void RealHardware::recordTraceButton(const ButtonEvent& event)
 {
-    static bool last_state = false;
-    bool current_state = isButtonAPressed();
-    bool was_pressed = (current_state && !last_state);
-    last_state = current_state;
-    return was_pressed;
+    char line[SENSOR_TRACE_LINE_MAX];
+    int len = sensor_trace_format_button(line, sizeof(line), event);
+    if (0 < len) {
+        Serial.write((const uint8_t*)line, len);
+    }
 }
 
-bool RealHardware::wasButtonBPressed()
+///////////////////////////////////////
+/// @brief 校正情報を記録（起動時・tare・校正時）
+void RealHardware::recordTraceCalibration()
 {
-    static bool last_state = false;
-    bool current_state = isButtonBPressed();
-    bool was_pressed = (current_state && !last_state);
-    last_state = current_state;
-    return was_pressed;
+    SensorTraceCalibration calib;
+    calib.offset = scale.get_offset();
+    calib.scale  = scale.get_scale();
+
+    char line[SENSOR_TRACE_LINE_MAX];
+    int len = sensor_trace_format_calibration(line, sizeof(line), calib);
+    if (0 < len) {
+        Serial.write((const uint8_t*)line, len);
+    }
+}
+
+bool RealHardware::isButtonAPressed()
+{
+    return button_events.isPressed(ButtonEvent::A);
+}
+
+bool RealHardware::isButtonBPressed()
+{
+    return button_events.isPressed(ButtonEvent::B);
+}
+
+bool RealHardware::popButtonEvent(ButtonEvent* event)
+{
+    portENTER_CRITICAL(&button_mux);
+    bool result = button_events.pop(event);
+    portEXIT_CRITICAL(&button_mux);
+#if SENSOR_TRACE_RECORD
+    if (result) {
+        recordTraceButton(*event);
+    }
+#endif
+    return result;
 }
 
 void RealHardware::getAccel(float* x, float* y, float* z)
@@ -195,7 +305,12 @@ float RealHardware::getWeightGrams()
         return 0.0f;
     }
 
-    return scale.get_units(10);
+    // get_units(10) と同じ計算を、トレースに残す生カウントを取り出せるよう分けて行う
+    int32_t raw = (int32_t)readScaleAverage(10);
+#if SENSOR_TRACE_RECORD
+    recordTraceSample(raw);
+#endif
+    return (float)(raw - scale.get_offset()) / scale.get_scale();
 #else
     return 0.0f;
 #endif
@@ -208,8 +323,11 @@ bool RealHardware::tareWeightSensor()
         return false;
     }
 
-    scale.tare();
+    scale.set_offset(readScaleAverage(10));
     Serial.println("[Weight] Tare completed");
+#if SENSOR_TRACE_RECORD
+    recordTraceCalibration();
+#endif
     return true;
 #else
     return false;
@@ -223,7 +341,7 @@ bool RealHardware::calibrateWeightSensor(float knownWeightGrams)
         return false;
     }
 
-    long adc = scale.read_average(20) - scale.get_offset();
+    long adc = readScaleAverage(20) - scale.get_offset();
     if (adc == 0) {
         return false;
     }
@@ -231,12 +349,30 @@ bool RealHardware::calibrateWeightSensor(float knownWeightGrams)
     float new_scale = adc / knownWeightGrams;
     scale.set_scale(new_scale);
     Serial.printf("[Weight] Calibrated. scale=%.3f (known=%.1fg)\n", new_scale, knownWeightGrams);
+#if SENSOR_TRACE_RECORD
+    recordTraceCalibration();
+#endif
     return true;
 #else
     return false;
 #endif
 }
 
+float RealHardware::getWeightScale()
+{
+    return scale.get_scale();
+}
+
+void RealHardware::setWeightScale(float new_scale)
+{
+    if (0.0f < new_scale) {
+        scale.set_scale(new_scale);
+#if SENSOR_TRACE_RECORD
+        recordTraceCalibration();
+#endif
+    }
+}
+
 void RealHardware::setBrightness(uint8_t brightness)
 {
     current_brightness = brightness;
@@ -248,22 +384,36 @@ uint8_t RealHardware::getBrightness()
 }
 
 // ====================================================================
-// WiFi機能実装（実機用）
+// 設定の保存先（実機用、NVS の "app" 名前空間に1つのblobとして保存）
 // ====================================================================
 
-bool RealHardware::hasWiFiConfig()
+size_t RealHardware::loadConfig(void* data, size_t size)
 {
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-    preferences.begin("wifi", true);
-    bool configured = preferences.getBool("configured", false);
+    preferences.begin("app", true);
+    size_t length = preferences.getBytesLength("config");
+    if (length != size) {
+        preferences.end();
+        return 0;
+    }
+    length = preferences.getBytes("config", data, size);
     preferences.end();
-    return configured;
-#else
-    return false;
-#endif
+    return length;
 }
 
-bool RealHardware::loadWiFiConfig(String& ssid, String& password)
+bool RealHardware::saveConfig(const void* data, size_t size)
+{
+    preferences.begin("app", false);
+    size_t written = preferences.putBytes("config", data, size);
+    preferences.end();
+    Serial.printf("[Config] %s (%u bytes)\n", written == size ? "Saved" : "Save failed", (unsigned)size);
+    return written == size;
+}
+
+// ====================================================================
+// WiFi機能実装（実機用、旧形式の設定の読み込み）
+// ====================================================================
+
+bool RealHardware::loadWiFiConfig(char* ssid, size_t ssid_size, char* password, size_t password_size)
 {
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
     preferences.begin("wifi", true);
@@ -273,44 +423,27 @@ bool RealHardware::loadWiFiConfig(String& ssid, String& password)
         return false;
     }
     
-    ssid = preferences.getString("ssid", "");
-    password = preferences.getString("password", "");
+    // 呼び出し側のバッファへ直接読み出す（String を経由しない）
+    ssid[0]     = '\0';
+    password[0] = '\0';
+    preferences.getString("ssid", ssid, ssid_size);
+    preferences.getString("password", password, password_size);
     preferences.end();
     
-    if (ssid.length() == 0) {
+    if ('\0' == ssid[0]) {
         return false;
     }
     
     return true;
 #else
+    (void)ssid;
+    (void)ssid_size;
+    (void)password;
+    (void)password_size;
     return false;
 #endif
 }
 
-void RealHardware::saveWiFiConfig(const String& ssid, const String& password)
-{
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-    preferences.begin("wifi", false);
-    preferences.putString("ssid", ssid);
-    preferences.putString("password", password);
-    preferences.putBool("configured", true);
-    preferences.end();
-    
-    Serial.println("[WiFi] Configuration saved");
-#endif
-}
-
-void RealHardware::clearWiFiConfig()
-{
-#if defined(ARDUINO) && defined(ESP_PLATFORM)
-    preferences.begin("wifi", false);
-    preferences.clear();
-    preferences.end();
-    
-    Serial.println("[WiFi] Configuration cleared");
-#endif
-}
-
 WiFiStatus RealHardware::getWiFiStatus()
 {
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
@@ -326,13 +459,13 @@ WiFiStatus RealHardware::getWiFiStatus()
     return wifi_status;
 }
 
-bool RealHardware::connectWiFi(const String& ssid, const String& password)
+bool RealHardware::connectWiFi(const char* ssid, const char* password)
 {
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
-    Serial.printf("[WiFi] Connecting to '%s'...\n", ssid.c_str());
+    Serial.printf("[WiFi] Connecting to '%s'...\n", ssid);
     
     WiFi.mode(WIFI_STA);
-    WiFi.begin(ssid.c_str(), password.c_str());
+    WiFi.begin(ssid, password);
     
     wifi_status = WiFiStatus::CONNECTING;
     wifi_connect_start = millis();
@@ -367,7 +500,9 @@ int RealHardware::scanNetworks(WiFiNetwork* networks, int maxNetworks)
     int count = (n < maxNetworks) ? n : maxNetworks;
     
     for (int i = 0; i < count; i++) {
-        networks[i].ssid = WiFi.SSID(i);
+        // WiFi.SSID() は String を返すため、スキャン結果のレコードから直接コピー
+        const wifi_ap_record_t* record = (const wifi_ap_record_t*)WiFi.getScanInfoByIndex(i);
+        snprintf(networks[i].ssid, sizeof(networks[i].ssid), "%s", record ? (const char*)record->ssid : "");
         networks[i].rssi = WiFi.RSSI(i);
         networks[i].isEncrypted = (WiFi.encryptionType(i) != WIFI_AUTH_OPEN);
     }
@@ -379,10 +514,10 @@ int RealHardware::scanNetworks(WiFiNetwork* networks, int maxNetworks)
 #endif
 }
 
-bool RealHardware::startAPMode(const String& ssid)
+bool RealHardware::startAPMode(const char* ssid)
 {
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
-    Serial.printf("[WiFi] Starting AP mode: %s\n", ssid.c_str());
+    Serial.printf("[WiFi] Starting AP mode: %s\n", ssid);
     
     // APモード設定
     WiFi.mode(WIFI_AP);
@@ -398,14 +533,14 @@ bool RealHardware::startAPMode(const String& ssid)
     }
     
     // APを起動
-    bool success = WiFi.softAP(ssid.c_str());
+    bool success = WiFi.softAP(ssid);
     
     if (success) {
         wifi_status = WiFiStatus::AP_MODE;
         IPAddress IP = WiFi.softAPIP();
         Serial.print("[WiFi] AP IP address: ");
         Serial.println(IP);
-        Serial.printf("[WiFi] AP SSID: %s (no password)\n", ssid.c_str());
+        Serial.printf("[WiFi] AP SSID: %s (no password)\n", ssid);
         Serial.println("[WiFi] AP started successfully - ready for connections");
         
         // 接続されているクライアント数を定期的に確認するためのログ
@@ -429,18 +564,19 @@ void RealHardware::stopAPMode()
 #endif
 }
 
-String RealHardware::getIPAddress()
+void RealHardware::getIPAddress(char* buf, size_t size)
 {
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
+    // IPAddress::toString() は String を返すため、各オクテットを直接整形
+    IPAddress ip(0, 0, 0, 0);
     if (wifi_status == WiFiStatus::CONNECTED) {
-        return WiFi.localIP().toString();
+        ip = WiFi.localIP();
     } else if (wifi_status == WiFiStatus::AP_MODE) {
-        return WiFi.softAPIP().toString();
-    } else {
-        return "0.0.0.0";
+        ip = WiFi.softAPIP();
     }
+    snprintf(buf, size, "%u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
 #else
-    return "0.0.0.0";
+    snprintf(buf, size, "0.0.0.0");
 #endif
 }
 
@@ -2,6 +2,7 @@
 #define __REAL_HARDWARE_HPP__
 
 #include "hardware_interface.hpp"
+#include "sensor_trace.hpp"
 
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
 #include <M5Unified.h>
@@ -13,51 +14,66 @@
 /**
  * @brief 実機環境用のハードウェア実装
  * M5Unifiedを使用
+ * HardwareInterface と同じ関数を持つが継承はしない（Hardware として直接呼ぶ、hardware.hpp）
  */
-class RealHardware : public HardwareInterface {
+class RealHardware {
 public:
     RealHardware();
-    ~RealHardware() override;
+    ~RealHardware();
     
-    void begin() override;
-    void update() override;
+    void begin();
+    void update();
     
     // ボタン関連
-    bool isButtonAPressed() override;
-    bool isButtonBPressed() override;
-    bool wasButtonAPressed() override;
-    bool wasButtonBPressed() override;
+    bool isButtonAPressed();
+    bool isButtonBPressed();
+    bool wasButtonAPressed()
+    {
+        bool result      = btnA_was_pressed;
+        btnA_was_pressed = false;  // 読み取り後クリア
+        return result;
+    }
+    bool wasButtonBPressed()
+    {
+        bool result      = btnB_was_pressed;
+        btnB_was_pressed = false;  // 読み取り後クリア
+        return result;
+    }
+    bool popButtonEvent(ButtonEvent* event);
     
     // IMU
-    void getAccel(float* x, float* y, float* z) override;
-    void getGyro(float* x, float* y, float* z) override;
+    void getAccel(float* x, float* y, float* z);
+    void getGyro(float* x, float* y, float* z);
     
     // バッテリー
-    float getBatteryVoltage() override;
-    int getBatteryLevel() override;
+    float getBatteryVoltage();
+    int getBatteryLevel();
 
     // 重量センサー（Scales Kit / HX711）
-    bool hasWeightSensor() override;
-    float getWeightGrams() override;
-    bool tareWeightSensor() override;
-    bool calibrateWeightSensor(float knownWeightGrams) override;
+    bool hasWeightSensor();
+    float getWeightGrams();
+    bool tareWeightSensor();
+    bool calibrateWeightSensor(float knownWeightGrams);
+    float getWeightScale();
+    void setWeightScale(float new_scale);
     
     // LCD輝度
-    void setBrightness(uint8_t brightness) override;
-    uint8_t getBrightness() override;
+    void setBrightness(uint8_t brightness);
+    uint8_t getBrightness();
     
-    // WiFi機能 (ESP32 Preferences使用)
-    bool hasWiFiConfig() override;
-    bool loadWiFiConfig(String& ssid, String& password) override;
-    void saveWiFiConfig(const String& ssid, const String& password) override;
-    void clearWiFiConfig() override;
-    WiFiStatus getWiFiStatus() override;
-    bool connectWiFi(const String& ssid, const String& password) override;
-    void disconnectWiFi() override;
-    int scanNetworks(WiFiNetwork* networks, int maxNetworks) override;
-    bool startAPMode(const String& ssid) override;
-    void stopAPMode() override;
-    String getIPAddress() override;
+    // 設定の保存先 (ESP32 Preferences使用)
+    size_t loadConfig(void* data, size_t size);
+    bool saveConfig(const void* data, size_t size);
+
+    // WiFi機能 (旧形式の設定は Preferences の "wifi")
+    bool loadWiFiConfig(char* ssid, size_t ssid_size, char* password, size_t password_size);
+    WiFiStatus getWiFiStatus();
+    bool connectWiFi(const char* ssid, const char* password);
+    void disconnectWiFi();
+    int scanNetworks(WiFiNetwork* networks, int maxNetworks);
+    bool startAPMode(const char* ssid);
+    void stopAPMode();
+    void getIPAddress(char* buf, size_t size);
 
 private:
     uint8_t current_brightness;
@@ -69,6 +85,19 @@ private:
     bool scale_ready;
     WiFiStatus wifi_status;
     unsigned long wifi_connect_start;
+    bool btnA_prev;  // update() 時点のボタン状態（wasButtonXPressed の立ち上がり検出用）
+    bool btnB_prev;
+    bool btnA_was_pressed;
+    bool btnB_was_pressed;
+
+#if defined(ARDUINO) && defined(ESP_PLATFORM)
+    long readScaleAverage(uint8_t times);
+#endif
+
+    // センサートレース記録（SENSOR_TRACE_RECORD=1 でシリアルへ出力）
+    void recordTraceSample(int32_t raw);
+    void recordTraceButton(const ButtonEvent& event);
+    void recordTraceCalibration();
 };
 
 #endif  // __REAL_HARDWARE_HPP__
@@ -0,0 +1,21 @@
+#include "sensor_snapshot.hpp"
+
+#include <string.h>
+
+#include "seqlock.hpp"
+
+static Seqlock<SensorSnapshot> sensor_snapshot;
+
+void sensor_snapshot_publish(const SensorSnapshot& snapshot)
+{
+    sensor_snapshot.publish(snapshot);
+}
+
+uint32_t sensor_snapshot_read(SensorSnapshot* snapshot)
+{
+    uint32_t serial = sensor_snapshot.read(snapshot);
+    if (0 == serial) {
+        memset(snapshot, 0, sizeof(*snapshot));
+    }
+    return serial;
+}
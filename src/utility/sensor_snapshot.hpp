@@ -0,0 +1,35 @@
+#ifndef __SENSOR_SNAPSHOT_HPP__
+#define __SENSOR_SNAPSHOT_HPP__
+
+#include <stdint.h>
+
+#include "hardware_interface.hpp"
+
+/**
+ * @brief センサーの最新値（計測タスクが公開し、画面・Webサーバーなどが読む）
+ * 読み出し側は HardwareInterface を呼ばないため、バスの通信や HX711 の変換待ちが発生しない。
+ */
+struct SensorSnapshot {
+    uint32_t time_ms;        // 最後に更新した時刻
+    uint32_t weight_serial;  // 重量サンプルの通し番号（新しいサンプルの検出用）
+    float weight_grams;      // 重量 [g]
+    bool weight_valid;       // 重量センサーが接続されているか
+    float accel[3];          // 加速度 [G]
+    float gyro[3];           // 角速度 [deg/s]
+    float battery_voltage;   // バッテリー電圧 [V]
+    int8_t battery_level;    // バッテリー残量 [%]
+    WiFiStatus wifi_status;  // WiFi接続状態
+};
+
+/**
+ * @brief 最新値を公開（計測タスクからのみ呼ぶ）
+ */
+void sensor_snapshot_publish(const SensorSnapshot& snapshot);
+
+/**
+ * @brief 最新値をコピー（どのタスクからも呼べる、ロックなし）
+ * @return 公開された回数（0=まだ公開されていない、snapshot はゼロ埋め）
+ */
+uint32_t sensor_snapshot_read(SensorSnapshot* snapshot);
+
+#endif  // __SENSOR_SNAPSHOT_HPP__
@@ -0,0 +1,111 @@
+#include "sensor_trace.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+
+int sensor_trace_format_sample(char* out, size_t out_size, const SensorTraceSample& sample)
+{
+    return snprintf(out, out_size, "S,%lu,%ld,%.4f,%.4f,%.4f,%.2f,%.2f,%.2f,%u\n",
+                    (unsigned long)sample.time_ms, (long)sample.raw,
+                    sample.accel[0], sample.accel[1], sample.accel[2],
+                    sample.gyro[0], sample.gyro[1], sample.gyro[2],
+                    (unsigned)sample.buttons);
+}
+
+int sensor_trace_format_calibration(char* out, size_t out_size, const SensorTraceCalibration& calib)
+{
+    return snprintf(out, out_size, "H,%ld,%.5f\n", (long)calib.offset, calib.scale);
+}
+
+int sensor_trace_format_button(char* out, size_t out_size, const ButtonEvent& edge)
+{
+    return snprintf(out, out_size, "B,%lu,%u,%u\n", (unsigned long)edge.time_ms, (unsigned)edge.button,
+                    edge.pressed ? 1u : 0u);
+}
+
+// カンマ区切りの次のフィールドへ進む（末尾なら nullptr）
+static const char* next_field(const char* p)
+{
+    while (*p != '\0' && *p != ',') {
+        p++;
+    }
+    return (',' == *p) ? (p + 1) : nullptr;
+}
+
+char sensor_trace_parse_line(const char* line, SensorTraceSample* sample, SensorTraceCalibration* calib,
+                             ButtonEvent* edge)
+{
+    if (nullptr == line || ',' != line[1]) {
+        return 0;
+    }
+
+    const char* p = line + 2;
+    char* end     = nullptr;
+
+    if ('H' == line[0] && calib) {
+        long offset = strtol(p, &end, 10);
+        if (end == p || nullptr == (p = next_field(p))) {
+            return 0;
+        }
+        float scale = strtof(p, &end);
+        if (end == p) {
+            return 0;
+        }
+        calib->offset = (int32_t)offset;
+        calib->scale  = scale;
+        return 'H';
+    }
+
+    if ('S' == line[0] && sample) {
+        SensorTraceSample s;
+        s.time_ms = (uint32_t)strtoul(p, &end, 10);
+        if (end == p || nullptr == (p = next_field(p))) {
+            return 0;
+        }
+        s.raw = (int32_t)strtol(p, &end, 10);
+        if (end == p) {
+            return 0;
+        }
+
+        float* values[6] = {&s.accel[0], &s.accel[1], &s.accel[2], &s.gyro[0], &s.gyro[1], &s.gyro[2]};
+        for (int i = 0; i < 6; i++) {
+            if (nullptr == (p = next_field(p))) {
+                return 0;
+            }
+            *values[i] = strtof(p, &end);
+            if (end == p) {
+                return 0;
+            }
+        }
+
+        // ボタン列は省略可
+        s.buttons = 0;
+        if (nullptr != (p = next_field(p))) {
+            s.buttons = (uint8_t)strtoul(p, nullptr, 10);
+        }
+
+        *sample = s;
+        return 'S';
+    }
+
+    if ('B' == line[0] && edge) {
+        ButtonEvent b;
+        b.time_ms = (uint32_t)strtoul(p, &end, 10);
+        if (end == p || nullptr == (p = next_field(p))) {
+            return 0;
+        }
+        b.button = (uint8_t)strtoul(p, &end, 10);
+        if (end == p || nullptr == (p = next_field(p))) {
+            return 0;
+        }
+        unsigned long pressed = strtoul(p, &end, 10);
+        if (end == p) {
+            return 0;
+        }
+        b.pressed = (0 != pressed);
+
+        *edge = b;
+        return 'B';
+    }
+
+    return 0;
+}
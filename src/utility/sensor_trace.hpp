@@ -0,0 +1,76 @@
+#ifndef __SENSOR_TRACE_HPP__
+#define __SENSOR_TRACE_HPP__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hardware_interface.hpp"
+
+/**
+ * @brief センサートレースの1サンプル（生データ）
+ * 実機で記録し、エミュレーターで再生する
+ */
+struct SensorTraceSample {
+    uint32_t time_ms;  // 記録時刻 [ms]
+    int32_t raw;       // HX711 生カウント
+    float accel[3];    // 加速度 [G]
+    float gyro[3];     // 角速度 [dps]
+    uint8_t buttons;   // サンプル時点のボタン状態（bit0=A, bit1=B、再生は B 行があればそちらを使う）
+};
+
+/**
+ * @brief センサートレースの校正情報（生カウント→グラム変換）
+ */
+struct SensorTraceCalibration {
+    int32_t offset;  // tare オフセット [count]
+    float scale;     // 換算係数 [count/g]
+};
+
+static const uint8_t SENSOR_TRACE_BUTTON_A = 0x01;
+static const uint8_t SENSOR_TRACE_BUTTON_B = 0x02;
+
+// 1行の最大長（改行・終端含む）
+static const size_t SENSOR_TRACE_LINE_MAX = 128;
+
+/**
+ * @brief サンプルを1行のテキストに変換
+ * 形式: "S,<time_ms>,<raw>,<ax>,<ay>,<az>,<gx>,<gy>,<gz>,<buttons>\n"
+ * @return 書き込んだ文字数（終端除く）
+ */
+int sensor_trace_format_sample(char* out, size_t out_size, const SensorTraceSample& sample);
+
+/**
+ * @brief 校正情報を1行のテキストに変換
+ * 形式: "H,<offset>,<scale>\n"
+ * @return 書き込んだ文字数（終端除く）
+ */
+int sensor_trace_format_calibration(char* out, size_t out_size, const SensorTraceCalibration& calib);
+
+/**
+ * @brief ボタンのエッジ（デバウンス済み）を1行のテキストに変換
+ * 重量サンプル（約1秒ごと）の間に収まる短い押下も再生できるよう、サンプルとは別に押下・解放ごとに記録する
+ * 形式: "B,<time_ms>,<button>,<pressed>\n"
+ * @return 書き込んだ文字数（終端除く）
+ */
+int sensor_trace_format_button(char* out, size_t out_size, const ButtonEvent& edge);
+
+/**
+ * @brief 1行を解析
+ * シリアルログに混在する他の行は無視できるよう、該当しない行は 0 を返す
+ * @return 'S' = サンプル、'H' = 校正情報、'B' = ボタンのエッジ、0 = 該当なし
+ */
+char sensor_trace_parse_line(const char* line, SensorTraceSample* sample, SensorTraceCalibration* calib,
+                             ButtonEvent* edge = nullptr);
+
+/**
+ * @brief 生カウントをグラムに変換
+ */
+inline float sensor_trace_to_grams(const SensorTraceCalibration& calib, int32_t raw)
+{
+    if (0.0f == calib.scale) {
+        return 0.0f;
+    }
+    return (float)(raw - calib.offset) / calib.scale;
+}
+
+#endif  // __SENSOR_TRACE_HPP__
@@ -0,0 +1,93 @@
+#ifndef __SEQLOCK_HPP__
+#define __SEQLOCK_HPP__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+#include <type_traits>
+
+/**
+ * @brief 書き込み1つ・読み出し複数のシーケンスロック
+ * 書き込み側は通し番号を奇数にしてから値を書き、偶数に戻して公開する。読み出し側は通し番号が偶数で、
+ * コピーの前後で変わっていなければ一貫した値とみなす（変わっていれば読み直す）。
+ * 読み出し側はロックを取らず、書き込み側を待たせることもない。
+ * 値は32ビットのアトミック変数に分けて保持する（読み出しと書き込みが重なってもデータ競合にならない）。
+ * 同じコアで書き込み側より優先度の高いタスクから読むと、書き込み途中で読み直しが続くため、
+ * 書き込み側の優先度は読み出し側以上にすること。
+ */
+template <typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock requires a trivially copyable type");
+
+public:
+    Seqlock() : seq(0), retries(0)
+    {
+        for (size_t i = 0; i < WORDS; i++) {
+            words[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief 値を公開（書き込み側は1つのタスクに限る）
+     */
+    void publish(const T& value)
+    {
+        uint32_t buf[WORDS] = {};
+        memcpy(buf, &value, sizeof(T));
+
+        uint32_t s = seq.load(std::memory_order_relaxed);
+        seq.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; i++) {
+            words[i].store(buf[i], std::memory_order_relaxed);
+        }
+        seq.store(s + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief 最新の値をコピー
+     * @return 公開した回数（0=まだ公開されていない、value は初期値のまま）
+     */
+    uint32_t read(T* value) const
+    {
+        uint32_t buf[WORDS];
+        uint32_t before;
+        uint32_t after;
+        for (;;) {
+            before = seq.load(std::memory_order_acquire);
+            for (size_t i = 0; i < WORDS; i++) {
+                buf[i] = words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = seq.load(std::memory_order_relaxed);
+            if (0 == (before & 1) && before == after) {
+                break;
+            }
+            retries.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (0 == before) {
+            return 0;
+        }
+        memcpy(value, buf, sizeof(T));
+        return before / 2;
+    }
+
+    /**
+     * @brief 書き込みと重なって読み直した回数（全読み出し側の合計）
+     */
+    uint32_t getRetries(void) const
+    {
+        return retries.load(std::memory_order_relaxed);
+    }
+
+private:
+    static const size_t WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    std::atomic<uint32_t> seq;
+    std::atomic<uint32_t> words[WORDS];
+    mutable std::atomic<uint32_t> retries;
+};
+
+#endif  // __SEQLOCK_HPP__
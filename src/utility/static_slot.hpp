@@ -0,0 +1,53 @@
+#ifndef __STATIC_SLOT_HPP__
+#define __STATIC_SLOT_HPP__
+
+#include <new>
+#include <utility>
+
+/**
+ * @brief オブジェクト1つ分の静的領域
+ * 必要になった時点で生成し、不要になったら破棄する長寿命のオブジェクト（Webサーバーなど）を
+ * ヒープを使わずに置く。生成済みの状態で create() すると、前のオブジェクトを破棄してから生成する。
+ */
+template <typename T>
+class StaticSlot {
+public:
+    StaticSlot() : object(nullptr)
+    {
+    }
+
+    ~StaticSlot()
+    {
+        destroy();
+    }
+
+    StaticSlot(const StaticSlot&)            = delete;
+    StaticSlot& operator=(const StaticSlot&) = delete;
+
+    template <typename... Args>
+    T* create(Args&&... args)
+    {
+        destroy();
+        object = new (storage) T(std::forward<Args>(args)...);
+        return object;
+    }
+
+    void destroy(void)
+    {
+        if (object) {
+            object->~T();
+            object = nullptr;
+        }
+    }
+
+    T* get(void) const
+    {
+        return object;
+    }
+
+private:
+    alignas(T) unsigned char storage[sizeof(T)];
+    T* object;
+};
+
+#endif  // __STATIC_SLOT_HPP__
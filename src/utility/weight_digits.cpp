@@ -0,0 +1,223 @@
+#include "weight_digits.hpp"
+
+#include <string.h>
+
+namespace {
+
+const int GLYPH_COUNT = 12;  // 0〜9, '-', '.'
+const int GLYPH_MINUS = 10;
+const int GLYPH_DOT   = 11;
+
+constexpr float SEG_R   = 3.0f;  // セグメントの太さの半分 [px]
+constexpr float SEG_GAP = 2.0f;  // セグメント端の隙間 [px]
+
+// セグメント a〜g の端点（x0, y0, x1, y1）
+constexpr float SEG_LEFT   = SEG_R + 0.5f;
+constexpr float SEG_RIGHT  = WeightDigits::CELL_W - SEG_R - 0.5f;
+constexpr float SEG_TOP    = SEG_R + 0.5f;
+constexpr float SEG_MID    = WeightDigits::CELL_H / 2.0f;
+constexpr float SEG_BOTTOM = WeightDigits::CELL_H - SEG_R - 0.5f;
+
+constexpr float SEGMENTS[7][4] = {
+    {SEG_LEFT, SEG_TOP, SEG_RIGHT, SEG_TOP},        // a
+    {SEG_RIGHT, SEG_TOP, SEG_RIGHT, SEG_MID},       // b
+    {SEG_RIGHT, SEG_MID, SEG_RIGHT, SEG_BOTTOM},    // c
+    {SEG_LEFT, SEG_BOTTOM, SEG_RIGHT, SEG_BOTTOM},  // d
+    {SEG_LEFT, SEG_MID, SEG_LEFT, SEG_BOTTOM},      // e
+    {SEG_LEFT, SEG_TOP, SEG_LEFT, SEG_MID},         // f
+    {SEG_LEFT, SEG_MID, SEG_RIGHT, SEG_MID},        // g
+};
+
+// グリフごとの点灯セグメント（bit0=a 〜 bit6=g）
+constexpr uint8_t SEGMENT_MASKS[GLYPH_COUNT] = {
+    0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F,  // 0〜9
+    0x40,                                                        // '-'
+    0x00,                                                        // '.'（別形状）
+};
+
+constexpr float abs_f(float v)
+{
+    return (v < 0.0f) ? -v : v;
+}
+
+constexpr float max_f(float a, float b)
+{
+    return (a < b) ? b : a;
+}
+
+// 両端を尖らせた六角形のセグメントに点 (x, y) が含まれるか
+constexpr bool in_segment(const float* seg, float x, float y)
+{
+    if (seg[1] == seg[3]) {
+        float over = max_f(0.0f, max_f(seg[0] + SEG_GAP - x, x - (seg[2] - SEG_GAP)));
+        return abs_f(y - seg[1]) + over <= SEG_R;
+    }
+    float over = max_f(0.0f, max_f(seg[1] + SEG_GAP - y, y - (seg[3] - SEG_GAP)));
+    return abs_f(x - seg[0]) + over <= SEG_R;
+}
+
+constexpr bool glyph_covers(int glyph, float x, float y)
+{
+    if (GLYPH_DOT == glyph) {
+        float dx = x - WeightDigits::DOT_W / 2.0f;
+        float dy = y - SEG_BOTTOM;
+        return dx * dx + dy * dy <= (SEG_R + 0.5f) * (SEG_R + 0.5f);
+    }
+    for (int s = 0; s < 7; s++) {
+        if ((SEGMENT_MASKS[glyph] & (1 << s)) && in_segment(SEGMENTS[s], x, y)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+struct GlyphAtlas {
+    uint8_t pixels[GLYPH_COUNT][WeightDigits::CELL_H][WeightDigits::CELL_W];
+};
+
+// 1ピクセルあたり 2x2 サンプルで縁をアンチエイリアス
+constexpr GlyphAtlas build_atlas(void)
+{
+    GlyphAtlas atlas{};
+    for (int g = 0; g < GLYPH_COUNT; g++) {
+        for (int y = 0; y < WeightDigits::CELL_H; y++) {
+            for (int x = 0; x < WeightDigits::CELL_W; x++) {
+                int hits = 0;
+                for (int sy = 0; sy < 2; sy++) {
+                    for (int sx = 0; sx < 2; sx++) {
+                        hits += glyph_covers(g, x + 0.25f + sx * 0.5f, y + 0.25f + sy * 0.5f) ? 1 : 0;
+                    }
+                }
+                atlas.pixels[g][y][x] = (uint8_t)((4 == hits) ? 255 : hits * 64);
+            }
+        }
+    }
+    return atlas;
+}
+
+alignas(4) constexpr GlyphAtlas ATLAS = build_atlas();
+
+lv_image_dsc_t glyph_images[GLYPH_COUNT];
+
+void init_glyph_images(void)
+{
+    if (LV_IMAGE_HEADER_MAGIC == glyph_images[0].header.magic) {
+        return;
+    }
+    for (int g = 0; g < GLYPH_COUNT; g++) {
+        lv_image_dsc_t& img = glyph_images[g];
+        memset(&img, 0, sizeof(img));
+        img.header.magic  = LV_IMAGE_HEADER_MAGIC;
+        img.header.cf     = LV_COLOR_FORMAT_A8;
+        img.header.w      = (GLYPH_DOT == g) ? WeightDigits::DOT_W : WeightDigits::CELL_W;
+        img.header.h      = WeightDigits::CELL_H;
+        img.header.stride = WeightDigits::CELL_W;  // 小数点もアトラスの1セル幅で並ぶ
+        img.data_size     = sizeof(ATLAS.pixels[g]);
+        img.data          = &ATLAS.pixels[g][0][0];
+    }
+}
+
+int glyph_index(char c)
+{
+    if ('0' <= c && c <= '9') {
+        return c - '0';
+    }
+    if ('-' == c) {
+        return GLYPH_MINUS;
+    }
+    if ('.' == c) {
+        return GLYPH_DOT;
+    }
+    return -1;
+}
+
+}  // namespace
+
+WeightDigits::WeightDigits() : container(nullptr), cells(), glyphs(), cell_x(), text_width(0), color(lv_color_black())
+{
+}
+
+void WeightDigits::create(lv_obj_t* parent)
+{
+    init_glyph_images();
+
+    container = lv_obj_create(parent);
+    lv_obj_remove_style_all(container);
+    lv_obj_remove_flag(container, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_remove_flag(container, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_set_size(container, WIDTH, CELL_H);
+    lv_obj_add_event_cb(container, onContainerDeleted, LV_EVENT_DELETE, this);
+
+    for (int i = 0; i < MAX_CELLS; i++) {
+        cells[i] = lv_image_create(container);
+        lv_obj_set_style_image_recolor(cells[i], color, LV_PART_MAIN);
+        lv_obj_set_style_image_recolor_opa(cells[i], LV_OPA_COVER, LV_PART_MAIN);
+        lv_obj_add_flag(cells[i], LV_OBJ_FLAG_HIDDEN);
+        glyphs[i] = -1;
+        cell_x[i] = 0;
+    }
+    text_width = 0;
+}
+
+// 削除された桁を指したままにしない（作り直した後に古い表示が削除された場合は何もしない）
+void WeightDigits::onContainerDeleted(lv_event_t* e)
+{
+    WeightDigits* self = static_cast<WeightDigits*>(lv_event_get_user_data(e));
+    if (self->container != lv_event_get_target(e)) {
+        return;
+    }
+    self->container = nullptr;
+    for (int i = 0; i < MAX_CELLS; i++) {
+        self->cells[i] = nullptr;
+    }
+}
+
+void WeightDigits::setText(const char* text)
+{
+    if (nullptr == container) {
+        return;
+    }
+
+    int len  = (int)strlen(text);
+    int x    = WIDTH;  // レイアウトの更新を待たずに決まるよう、定数の幅から詰める
+    int left = WIDTH;  // 左端の桁の位置
+    for (int i = 0; i < MAX_CELLS; i++) {
+        int glyph = (i < len) ? glyph_index(text[len - 1 - i]) : -1;
+        if (0 <= glyph) {
+            x -= (GLYPH_DOT == glyph) ? DOT_W : CELL_W;
+        }
+
+        // 文字・位置が同じ桁には触れない（無効化しない）
+        if (glyph != glyphs[i] || (0 <= glyph && x != cell_x[i])) {
+            if (glyph < 0) {
+                lv_obj_add_flag(cells[i], LV_OBJ_FLAG_HIDDEN);
+            } else {
+                lv_image_set_src(cells[i], &glyph_images[glyph]);
+                lv_obj_set_pos(cells[i], x, 0);
+                lv_obj_remove_flag(cells[i], LV_OBJ_FLAG_HIDDEN);
+                cell_x[i] = (int16_t)x;
+            }
+            glyphs[i] = (int8_t)glyph;
+        }
+
+        if (0 <= glyph) {
+            left = x;
+            x -= SPACING;
+        }
+    }
+    text_width = (int16_t)(WIDTH - left);
+}
+
+void WeightDigits::setColor(lv_color_t new_color)
+{
+    if (lv_color_eq(color, new_color)) {
+        return;
+    }
+    color = new_color;
+    if (nullptr == container) {
+        return;
+    }
+    for (int i = 0; i < MAX_CELLS; i++) {
+        lv_obj_set_style_image_recolor(cells[i], color, LV_PART_MAIN);
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef __WEIGHT_DIGITS_HPP__
+#define __WEIGHT_DIGITS_HPP__
+
+#include <stdint.h>
+
+#include "lvgl.h"
+
+/**
+ * @brief 重量表示用の大型7セグメント数字
+ * 0〜9・'.'・'-' のグリフはコンパイル時に生成したA8アトラス（フラッシュ上）から描画する。
+ * 1文字を1つの画像オブジェクトとし、文字・位置が変わった桁だけを更新するため、
+ * LVGLが無効化するのは変化した桁の領域のみ。
+ * テキストは右揃えで表示し、対応しない文字は空白として扱う。
+ */
+class WeightDigits {
+public:
+    static const int CELL_W    = 24;  // 数字1桁の幅 [px]
+    static const int CELL_H    = 44;  // 高さ [px]
+    static const int DOT_W     = 10;  // 小数点の幅 [px]
+    static const int SPACING   = 2;   // 桁の間隔 [px]
+    static const int MAX_CELLS = 7;   // 最大桁数（小数点を含む）
+    static const int WIDTH     = MAX_CELLS * CELL_W + (MAX_CELLS - 1) * SPACING;  // 表示オブジェクトの幅 [px]
+
+    WeightDigits();
+
+    /**
+     * @brief 表示オブジェクトを作成（画面を作り直すたびに呼ぶ）
+     * 大きさは MAX_CELLS 桁分で固定、桁は右端から詰めて配置する。
+     * 表示オブジェクトが削除されたら（lv_obj_clean() など）次の create() まで何もしない
+     */
+    void create(lv_obj_t* parent);
+
+    lv_obj_t* getObject(void) const
+    {
+        return container;
+    }
+
+    void setText(const char* text);
+    void setColor(lv_color_t color);
+
+    /**
+     * @brief 表示中のテキストの幅 [px]（右端から左端の桁まで）
+     */
+    int getTextWidth(void) const
+    {
+        return text_width;
+    }
+
+private:
+    static void onContainerDeleted(lv_event_t* e);
+
+    lv_obj_t* container;
+    lv_obj_t* cells[MAX_CELLS];  // 右端から順
+    int8_t glyphs[MAX_CELLS];    // 表示中のグリフ（-1=空白）
+    int16_t cell_x[MAX_CELLS];
+    int16_t text_width;
+    lv_color_t color;
+};
+
+#endif  // __WEIGHT_DIGITS_HPP__
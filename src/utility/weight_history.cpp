@@ -0,0 +1,151 @@
+#include "weight_history.hpp"
+
+// 各段のバケット幅 [ms]
+static const uint32_t PERIOD_MS[WeightHistory::TIER_COUNT] = {
+    1000UL,          // 1秒
+    60UL * 1000UL,   // 1分
+    900UL * 1000UL,  // 15分
+};
+
+WeightHistory::WeightHistory()
+{
+    const uint16_t capacities[TIER_COUNT] = {CAPACITY_1S, CAPACITY_1MIN, CAPACITY_15MIN};
+
+    WeightBucket* slots = storage;
+    for (int i = 0; i < TIER_COUNT; i++) {
+        rings[i].slots    = slots;
+        rings[i].capacity = capacities[i];
+        slots += capacities[i];
+    }
+    clear();
+}
+
+void WeightHistory::clear()
+{
+    for (int i = 0; i < TIER_COUNT; i++) {
+        Ring& r         = rings[i];
+        r.head          = 0;
+        r.size          = 0;
+        r.serial        = 0;
+        r.open_start_ms = 0;
+        r.started       = false;
+        reset(r.open);
+    }
+}
+
+void WeightHistory::add(float grams, uint32_t now_ms)
+{
+    WeightBucket sample;
+    sample.min   = grams;
+    sample.max   = grams;
+    sample.mean  = grams;
+    sample.count = 1;
+    feed(TIER_1S, sample, now_ms);
+}
+
+void WeightHistory::feed(int tier, const WeightBucket& sample, uint32_t now_ms)
+{
+    Ring& r         = rings[tier];
+    uint32_t period = PERIOD_MS[tier];
+
+    if (!r.started) {
+        r.started       = true;
+        r.open_start_ms = now_ms;
+    }
+
+    // 経過した区間を確定（サンプルの無い区間は count=0 の欠測バケットになる）
+    // 空白がリング1周を超えると集計中のバケットはリングに残らない：確定して上位段へ渡したら、
+    // 直近のリング1周分だけを欠測バケットで埋める（処理量を抑えつつ、古さが現在時刻と合うように）
+    uint32_t periods = (now_ms - r.open_start_ms) / period;
+    if (r.capacity < periods) {
+        close(tier);
+        r.open_start_ms = now_ms - (now_ms - r.open_start_ms) % period - r.capacity * period;
+    }
+    while (period <= now_ms - r.open_start_ms) {
+        close(tier);
+        r.open_start_ms += period;
+    }
+
+    merge(r.open, sample);
+}
+
+void WeightHistory::close(int tier)
+{
+    Ring& r = rings[tier];
+
+    r.slots[r.head] = r.open;
+    r.head          = (r.head + 1) % r.capacity;
+    if (r.size < r.capacity) {
+        r.size++;
+    }
+    r.serial++;
+
+    // 上位段へ集約（欠測バケットも時刻を進めるために渡す）
+    if (tier + 1 < TIER_COUNT) {
+        feed(tier + 1, r.open, r.open_start_ms);
+    }
+
+    reset(r.open);
+}
+
+uint16_t WeightHistory::count(Tier tier) const
+{
+    return rings[tier].size;
+}
+
+const WeightBucket& WeightHistory::bucket(Tier tier, uint16_t age) const
+{
+    const Ring& r = rings[tier];
+    uint16_t idx  = (r.head + r.capacity - 1 - (age % r.capacity)) % r.capacity;
+    return r.slots[idx];
+}
+
+uint16_t WeightHistory::summarize(Tier tier, uint16_t n, WeightBucket* out) const
+{
+    const Ring& r = rings[tier];
+    if (r.size < n) {
+        n = r.size;
+    }
+
+    reset(*out);
+    for (uint16_t age = 0; age < n; age++) {
+        merge(*out, bucket(tier, age));
+    }
+    return n;
+}
+
+uint32_t WeightHistory::closedSerial(Tier tier) const
+{
+    return rings[tier].serial;
+}
+
+uint32_t WeightHistory::periodMs(Tier tier)
+{
+    return PERIOD_MS[tier];
+}
+
+void WeightHistory::merge(WeightBucket& dst, const WeightBucket& src)
+{
+    if (0 == src.count) {
+        return;
+    }
+    if (0 == dst.count) {
+        dst = src;
+        return;
+    }
+
+    if (src.min < dst.min) dst.min = src.min;
+    if (dst.max < src.max) dst.max = src.max;
+
+    uint32_t total = dst.count + src.count;
+    dst.mean       = (dst.mean * dst.count + src.mean * src.count) / total;
+    dst.count      = total;
+}
+
+void WeightHistory::reset(WeightBucket& b)
+{
+    b.min   = 0.0f;
+    b.max   = 0.0f;
+    b.mean  = 0.0f;
+    b.count = 0;
+}
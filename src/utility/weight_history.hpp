@@ -0,0 +1,110 @@
+#ifndef __WEIGHT_HISTORY_HPP__
+#define __WEIGHT_HISTORY_HPP__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief 重量履歴の1バケット（区間内の min / max / mean / サンプル数）
+ */
+struct WeightBucket {
+    float min;       // 区間内の最小値 [g]
+    float max;       // 区間内の最大値 [g]
+    float mean;      // 区間内の平均値 [g]
+    uint32_t count;  // 区間内のサンプル数（0 = 欠測区間）
+};
+
+/**
+ * @brief 重量の多段ダウンサンプリング履歴（min/max/mean ピラミッド）
+ * 1秒・1分・15分の3段のバケットを固定長リングバッファで保持する。
+ * 下位段のバケットが閉じるたびに上位段へ集約するため、
+ * 履歴の問い合わせやグラフ描画は生サンプル数ではなくバケット数に比例する。
+ * ヒープは使用せず、使用メモリは memoryBytes() で固定。
+ */
+class WeightHistory {
+public:
+    enum Tier {
+        TIER_1S,     // 1秒バケット
+        TIER_1MIN,   // 1分バケット
+        TIER_15MIN,  // 15分バケット
+        TIER_COUNT
+    };
+
+    static const uint16_t CAPACITY_1S    = 60;  // 直近1分
+    static const uint16_t CAPACITY_1MIN  = 60;  // 直近1時間
+    static const uint16_t CAPACITY_15MIN = 96;  // 直近24時間
+
+    WeightHistory();
+
+    /**
+     * @brief サンプルを追加
+     * @param grams 重量 [g]
+     * @param now_ms サンプル時刻 [ms]（単調増加）
+     */
+    void add(float grams, uint32_t now_ms);
+
+    /**
+     * @brief 履歴をすべて破棄
+     */
+    void clear();
+
+    /**
+     * @brief 指定段の確定済みバケット数
+     */
+    uint16_t count(Tier tier) const;
+
+    /**
+     * @brief 指定段の確定済みバケットを取得
+     * @param age 0 = 最新の確定バケット、count(tier) - 1 = 最古
+     */
+    const WeightBucket& bucket(Tier tier, uint16_t age) const;
+
+    /**
+     * @brief 指定段の直近 n 個の確定バケットを1つに集約（O(n)）
+     * @return 集約したバケット数
+     */
+    uint16_t summarize(Tier tier, uint16_t n, WeightBucket* out) const;
+
+    /**
+     * @brief 指定段でこれまでに確定したバケットの通し番号
+     * 差分を見ることで、追加された分だけを逐次処理できる
+     */
+    uint32_t closedSerial(Tier tier) const;
+
+    /**
+     * @brief 指定段のバケット幅 [ms]
+     */
+    static uint32_t periodMs(Tier tier);
+
+    /**
+     * @brief 履歴が使用するメモリ量 [byte]
+     */
+    static constexpr size_t memoryBytes();
+
+private:
+    struct Ring {
+        WeightBucket* slots;     // 保存領域（storage内）
+        uint16_t capacity;       // 保存可能数
+        uint16_t head;           // 次に書き込む位置
+        uint16_t size;           // 確定済みバケット数
+        uint32_t serial;         // 確定済みバケットの通し番号
+        WeightBucket open;       // 集計中のバケット
+        uint32_t open_start_ms;  // 集計中バケットの開始時刻
+        bool started;            // 集計開始済みか
+    };
+
+    Ring rings[TIER_COUNT];
+    WeightBucket storage[CAPACITY_1S + CAPACITY_1MIN + CAPACITY_15MIN];
+
+    void feed(int tier, const WeightBucket& sample, uint32_t now_ms);
+    void close(int tier);
+    static void merge(WeightBucket& dst, const WeightBucket& src);
+    static void reset(WeightBucket& b);
+};
+
+constexpr size_t WeightHistory::memoryBytes()
+{
+    return sizeof(WeightHistory);
+}
+
+#endif  // __WEIGHT_HISTORY_HPP__
@@ -1,8 +1,12 @@
 #include "wifi_webserver.hpp"
+#include <stdio.h>
 #include <string.h>
 
-// エミュレーター環境用のSDLインクルード
-#if !defined(ARDUINO) || !defined(ESP_PLATFORM)
+#include "app_log.hpp"
+#include "sensor_snapshot.hpp"
+
+// エミュレーター環境用のSDLインクルード（ヘッドレスを除く）
+#if (!defined(ARDUINO) || !defined(ESP_PLATFORM)) && !defined(EMULATOR_HEADLESS)
     #if __has_include(<SDL2/SDL.h>)
         #include <SDL2/SDL.h>
     #elif __has_include(<SDL.h>)
@@ -29,50 +33,46 @@ WiFiWebServer::~WiFiWebServer()
 
 void WiFiWebServer::begin(int port)
 {
-    if (server) {
-        delete server;
-    }
-    
     // DNSサーバーを起動（キャプティブポータル用）
     if (!dnsServer) {
-        dnsServer = new DNSServer();
+        dnsServer = dns_slot.create();
     }
     dnsServer->start(53, "*", IPAddress(192, 168, 4, 1));
-    Serial.println("[WebServer] DNS Server started (captive portal mode)");
+    APP_LOGI("[WebServer] DNS Server started (captive portal mode)");
     
-    server = new WebServer(port);
+    server = server_slot.create(port);  // 起動済みなら作り直す
     
     // ルートハンドラ
     server->on("/", [this]() {
-        Serial.println("[WebServer] Root page requested");
+        APP_LOGI("[WebServer] Root page requested");
         server->send(200, "text/html", getIndexHTML());
     });
     
     // キャプティブポータル検出用エンドポイント（Android, iOS, Windows）
     server->on("/generate_204", [this]() {
-        Serial.println("[WebServer] Captive portal check (Android): /generate_204");
+        APP_LOGD("[WebServer] Captive portal check (Android): /generate_204");
         server->sendHeader("Location", "http://192.168.4.1/", true);
         server->send(302, "text/plain", "");
     });
     
     server->on("/hotspot-detect.html", [this]() {
-        Serial.println("[WebServer] Captive portal check (iOS): /hotspot-detect.html");
+        APP_LOGD("[WebServer] Captive portal check (iOS): /hotspot-detect.html");
         server->send(200, "text/html", getIndexHTML());
     });
     
     server->on("/connecttest.txt", [this]() {
-        Serial.println("[WebServer] Captive portal check (Windows): /connecttest.txt");
+        APP_LOGD("[WebServer] Captive portal check (Windows): /connecttest.txt");
         server->send(200, "text/plain", "Microsoft Connect Test");
     });
     
     server->on("/success.txt", [this]() {
-        Serial.println("[WebServer] Captive portal check: /success.txt");
+        APP_LOGD("[WebServer] Captive portal check: /success.txt");
         server->send(200, "text/plain", "success");
     });
     
     // WiFi設定受信ハンドラ
     server->on("/config", [this]() {
-        Serial.println("[WebServer] Config endpoint accessed");
+        APP_LOGI("[WebServer] Config endpoint accessed");
         if (server->hasArg("ssid") && server->hasArg("password")) {
             String ssid_str = server->arg("ssid");
             String pass_str = server->arg("password");
@@ -85,7 +85,7 @@ void WiFiWebServer::begin(int port)
             
             configured = true;
             
-            Serial.printf("[WebServer] WiFi config received: SSID=%s\n", ssid);
+            APP_LOGI("[WebServer] WiFi config received: SSID=%s", ssid);
             
             server->send(200, "text/html", 
                 "<html><body style='font-family:Arial;text-align:center;padding:50px;'>"
@@ -93,14 +93,14 @@ void WiFiWebServer::begin(int port)
                 "<p>Device will restart and connect to WiFi...</p>"
                 "</body></html>");
         } else {
-            Serial.println("[WebServer] Missing ssid or password parameter");
+            APP_LOGW("[WebServer] Missing ssid or password parameter");
             server->send(400, "text/html", "Missing parameters");
         }
     });
     
     // WiFiスキャンハンドラ
     server->on("/scan", [this]() {
-        Serial.println("[WebServer] Scan endpoint accessed");
+        APP_LOGI("[WebServer] Scan endpoint accessed");
         int n = WiFi.scanNetworks();
         String json = "[";
         
@@ -117,29 +117,44 @@ void WiFiWebServer::begin(int port)
         server->send(200, "application/json", json);
     });
     
+    // センサーの最新値（計測タスクが公開した値を返す、センサーへのアクセスはしない）
+    server->on("/sensors", [this]() {
+        SensorSnapshot snapshot;
+        sensor_snapshot_read(&snapshot);
+        char json[256];
+        snprintf(json, sizeof(json),
+                 "{\"time_ms\":%lu,\"weight_valid\":%s,\"weight_g\":%.1f,"
+                 "\"accel\":[%.3f,%.3f,%.3f],\"gyro\":[%.2f,%.2f,%.2f],"
+                 "\"battery_v\":%.2f,\"battery_pct\":%d,\"wifi_status\":%d}",
+                 (unsigned long)snapshot.time_ms, snapshot.weight_valid ? "true" : "false", snapshot.weight_grams,
+                 snapshot.accel[0], snapshot.accel[1], snapshot.accel[2], snapshot.gyro[0], snapshot.gyro[1],
+                 snapshot.gyro[2], snapshot.battery_voltage, (int)snapshot.battery_level, (int)snapshot.wifi_status);
+        server->send(200, "application/json", json);
+    });
+    
     // 404ハンドラーも追加してデバッグ（すべてのリクエストをルートにリダイレクト）
     server->onNotFound([this]() {
-        Serial.printf("[WebServer] Redirecting to root: %s\n", server->uri().c_str());
+        APP_LOGD("[WebServer] Redirecting to root: %s", server->uri().c_str());
         server->sendHeader("Location", "http://192.168.4.1/", true);
         server->send(302, "text/plain", "");
     });
     
     server->begin();
-    Serial.printf("[WebServer] Web server started on port %d\n", port);
-    Serial.println("[WebServer] Waiting for client connections...");
-    Serial.println("[WebServer] Registered routes: /, /config, /scan, /generate_204, /hotspot-detect.html, /connecttest.txt, /success.txt");
+    APP_LOGI("[WebServer] Web server started on port %d", port);
+    APP_LOGI("[WebServer] Waiting for client connections...");
+    APP_LOGI("[WebServer] Registered routes: /, /config, /scan, /sensors, /generate_204, /hotspot-detect.html, /connecttest.txt, /success.txt");
 }
 
 void WiFiWebServer::stop()
 {
     if (server) {
         server->stop();
-        delete server;
+        server_slot.destroy();
         server = nullptr;
     }
     if (dnsServer) {
         dnsServer->stop();
-        delete dnsServer;
+        dns_slot.destroy();
         dnsServer = nullptr;
     }
 }
@@ -397,16 +412,16 @@ void WiFiWebServer::begin(int port)
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
     // Arduino環境では何もしない（上のコードで処理済み）
 #else
-    printf("[WiFiWebServer] Starting web server on port %d (emulator mode)...\n", port);
-    printf("[WiFiWebServer] NOTE: This is a mock implementation.\n");
-    printf("[WiFiWebServer] To test WiFi configuration, manually call:\n");
-    printf("[WiFiWebServer]   Test SSID: TestSSID, Password: TestPassword\n");
+    APP_LOGI("[WiFiWebServer] Starting web server on port %d (emulator mode)...", port);
+    APP_LOGI("[WiFiWebServer] NOTE: This is a mock implementation.");
+    APP_LOGI("[WiFiWebServer] To test WiFi configuration, manually call:");
+    APP_LOGI("[WiFiWebServer]   Test SSID: TestSSID, Password: TestPassword");
 #endif
 }
 
 void WiFiWebServer::stop()
 {
-    printf("[WiFiWebServer] Stopping web server (emulator mode)...\n");
+    APP_LOGI("[WiFiWebServer] Stopping web server (emulator mode)...");
 }
 
 void WiFiWebServer::handleClient()
@@ -414,17 +429,16 @@ void WiFiWebServer::handleClient()
     // エミュレーター環境用：キーボード入力でWiFi設定をシミュレート
     // 'W'キーでWiFi設定を受信したことにする
 #if !defined(ARDUINO) || !defined(ESP_PLATFORM)
-    static bool key_pressed_last = false;
-    
     // SDL経由でキー状態を取得
-    #if __has_include(<SDL2/SDL.h>) || __has_include(<SDL.h>)
+    #if defined(SDL_h_)
+        static bool key_pressed_last = false;
         const Uint8* keystate = SDL_GetKeyboardState(NULL);
         bool key_pressed = keystate[SDL_SCANCODE_W] != 0;
         
         // 'W'キーの立ち上がりエッジを検出
         if (key_pressed && !key_pressed_last) {
-            printf("\n[WiFiWebServer] Simulating WiFi configuration received!\n");
-            printf("[WiFiWebServer] Press 'W' key detected - auto-configuring...\n");
+            APP_LOGI("[WiFiWebServer] Simulating WiFi configuration received!");
+            APP_LOGI("[WiFiWebServer] Press 'W' key detected - auto-configuring...");
             
             // テスト用のWiFi設定を保存
             strncpy(ssid, "TestSSID", sizeof(ssid) - 1);
@@ -435,7 +449,7 @@ void WiFiWebServer::handleClient()
             
             configured = true;
             
-            printf("[WiFiWebServer] Configuration saved: SSID=%s\n", ssid);
+            APP_LOGI("[WiFiWebServer] Configuration saved: SSID=%s", ssid);
         }
         
         key_pressed_last = key_pressed;
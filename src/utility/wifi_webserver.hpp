@@ -4,6 +4,8 @@
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
 #include <WebServer.h>
 #include <DNSServer.h>
+
+#include "static_slot.hpp"
 #endif
 
 /**
@@ -53,6 +55,8 @@ public:
 
 private:
 #if defined(ARDUINO) && defined(ESP_PLATFORM)
+    StaticSlot<WebServer> server_slot;  // ヒープを使わずに生成
+    StaticSlot<DNSServer> dns_slot;
     WebServer* server;
     DNSServer* dnsServer;
 #endif
@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+"""
+Compare two native benchmark outputs (JSON Lines from env:bench_native)
+
+  python3 support/bench_compare.py base.txt head.txt [--threshold 10]
+
+Prints ns/op per benchmark and the relative change. Exits with 1 when any
+benchmark got slower than the threshold (percent), so it can gate a CI job.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    results = {}
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith("{"):
+                continue
+            entry = json.loads(line)
+            results[entry["name"]] = entry
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("base")
+    parser.add_argument("head")
+    parser.add_argument("--threshold", type=float, default=10.0, help="regression threshold in percent")
+    args = parser.parse_args()
+
+    base = load(args.base)
+    head = load(args.head)
+
+    regressions = 0
+    print(f"{'benchmark':40} {'base ns':>12} {'head ns':>12} {'change':>9}")
+    for name in sorted(set(base) | set(head)):
+        if name not in base or name not in head:
+            side = "head" if name in head else "base"
+            print(f"{name:40} {'(only in ' + side + ')':>35}")
+            continue
+        b = base[name]["ns_per_op"]
+        h = head[name]["ns_per_op"]
+        change = (h - b) / b * 100.0 if b > 0 else 0.0
+        mark = ""
+        if change > args.threshold:
+            mark = "  <-- slower"
+            regressions += 1
+        print(f"{name:40} {b:12.1f} {h:12.1f} {change:+8.1f}%{mark}")
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
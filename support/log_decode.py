@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+"""
+Decode binary log frames (firmware built with -D APP_LOG_BINARY=1)
+
+  python3 support/log_decode.py .pio/build/board_StickCPlus2/firmware.elf capture.bin
+  python3 support/log_decode.py firmware.elf --port /dev/ttyUSB0 [--baud 115200]   (needs pyserial)
+
+The firmware sends the address of each format string instead of the text, so
+the strings are looked up in the ELF of the same build. Bytes outside a frame
+(boot messages, Serial output that does not go through APP_LOG) are passed
+through unchanged. Frame layout is documented in src/utility/app_log.cpp.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+FRAME_SYNC = 0xA5
+FRAME_HEADER = 2 + 4 + 4 + 1 + 1
+MAX_ARGS = 6
+LEVELS = "NEWID"
+
+ARG_I32, ARG_U32, ARG_I64, ARG_U64, ARG_F64, ARG_STR, ARG_NONE = range(7)
+ARG_SIZES = {ARG_I32: 4, ARG_U32: 4, ARG_I64: 8, ARG_U64: 8, ARG_F64: 8}
+ARG_FORMATS = {ARG_I32: "<i", ARG_U32: "<I", ARG_I64: "<q", ARG_U64: "<Q", ARG_F64: "<d"}
+
+SPEC = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)[hlLqjzt]*([diouxXcsfFeEgGaA%])")
+
+
+class ElfStrings:
+    """Loaded (SHF_ALLOC, non-NOBITS) sections of a little-endian ELF, to read C strings by address."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF" or data[5] != 1:
+            raise ValueError(f"{path}: not a little-endian ELF file")
+        is64 = data[4] == 2
+        if is64:
+            shoff, = struct.unpack_from("<Q", data, 0x28)
+            shentsize, shnum = struct.unpack_from("<HH", data, 0x3A)
+        else:
+            shoff, = struct.unpack_from("<I", data, 0x20)
+            shentsize, shnum = struct.unpack_from("<HH", data, 0x2E)
+
+        self.sections = []
+        for i in range(shnum):
+            base = shoff + i * shentsize
+            if is64:
+                _, sh_type, flags, addr, offset, size = struct.unpack_from("<IIQQQQ", data, base)
+            else:
+                _, sh_type, flags, addr, offset, size = struct.unpack_from("<IIIIII", data, base)
+            SHT_NOBITS, SHF_ALLOC = 8, 0x2
+            if (flags & SHF_ALLOC) and sh_type != SHT_NOBITS and size:
+                self.sections.append((addr, data[offset:offset + size]))
+
+    def string(self, addr):
+        for start, blob in self.sections:
+            if start <= addr < start + len(blob):
+                end = blob.find(b"\0", addr - start)
+                if end < 0:
+                    return None
+                return blob[addr - start:end].decode("utf-8", errors="replace")
+        return None
+
+
+def parse_args(types, payload):
+    """Raw argument values of one frame, or None if the payload does not match the types."""
+    values = []
+    pos = 0
+    for t in types:
+        if t in ARG_SIZES:
+            if len(payload) < pos + ARG_SIZES[t]:
+                return None
+            values.append(struct.unpack_from(ARG_FORMATS[t], payload, pos)[0])
+            pos += ARG_SIZES[t]
+        elif t == ARG_STR:
+            if len(payload) < pos + 1 or len(payload) < pos + 1 + payload[pos]:
+                return None
+            length = payload[pos]
+            values.append(payload[pos + 1:pos + 1 + length].decode("utf-8", errors="replace"))
+            pos += 1 + length
+        elif t == ARG_NONE:
+            values.append(None)
+        else:
+            return None
+    return values if pos == len(payload) else None
+
+
+def format_message(fmt, values):
+    """printf-style formatting with the C length modifiers removed."""
+    args = iter(values)
+
+    def convert(m):
+        flags, conv = m.group(1), m.group(2)
+        if conv == "%":
+            return "%"
+        value = next(args, None)
+        if value is None:
+            return "?"
+        try:
+            if conv == "c":
+                return ("%" + flags + "s") % chr(value)
+            if conv in "iu":
+                conv = "d"
+            return ("%" + flags + conv) % value
+        except (TypeError, ValueError, OverflowError):
+            return "?"
+
+    return SPEC.sub(convert, fmt)
+
+
+class Decoder:
+    def __init__(self, elf, out):
+        self.elf = elf
+        self.out = out
+        self.buffer = bytearray()
+
+    def feed(self, data):
+        self.buffer += data
+        while self.buffer:
+            sync = self.buffer.find(FRAME_SYNC)
+            if sync < 0:
+                self.passthrough(self.buffer)
+                self.buffer.clear()
+                return
+            if sync:
+                self.passthrough(self.buffer[:sync])
+                del self.buffer[:sync]
+            if len(self.buffer) < 2 or len(self.buffer) < 2 + self.buffer[1]:
+                return  # wait for the rest of the frame
+            frame = bytes(self.buffer[:2 + self.buffer[1]])
+            line = self.decode(frame)
+            if line is None:
+                self.passthrough(self.buffer[:1])
+                del self.buffer[:1]
+            else:
+                self.out.write(line)
+                del self.buffer[:len(frame)]
+        self.out.flush()
+
+    def decode(self, frame):
+        if len(frame) < FRAME_HEADER:
+            return None
+        addr, time_ms, level, nargs = struct.unpack_from("<IIBB", frame, 2)
+        if MAX_ARGS < nargs or len(frame) < FRAME_HEADER + nargs:
+            return None
+        fmt = self.elf.string(addr)
+        if fmt is None:
+            return None
+        types = frame[FRAME_HEADER:FRAME_HEADER + nargs]
+        values = parse_args(types, frame[FRAME_HEADER + nargs:])
+        if values is None:
+            return None
+        tag = LEVELS[level] if level < len(LEVELS) else "?"
+        return f"{tag} ({time_ms}) {format_message(fmt, values)}\n"
+
+    def passthrough(self, data):
+        self.out.write(bytes(data).decode("utf-8", errors="replace"))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="ELF of the running firmware (same build)")
+    parser.add_argument("capture", nargs="?", help="captured serial output (default: stdin)")
+    parser.add_argument("--port", help="read from a serial port instead (pyserial)")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+
+    decoder = Decoder(ElfStrings(args.elf), sys.stdout)
+    if args.port:
+        import serial
+
+        with serial.Serial(args.port, args.baud, timeout=0.1) as port:
+            while True:
+                decoder.feed(port.read(256))
+    else:
+        source = open(args.capture, "rb") if args.capture else sys.stdin.buffer
+        with source:
+            while True:
+                data = source.read(4096)
+                if not data:
+                    break
+                decoder.feed(data)
+        if decoder.buffer:
+            decoder.passthrough(decoder.buffer)
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except KeyboardInterrupt:
+        pass
@@ -0,0 +1,198 @@
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+
+#include <atomic>
+#include <thread>
+
+#include "app_log.hpp"
+#include "hardware_interface.hpp"
+
+// 遅延ログの検証
+// 整形結果が snprintf と一致すること、複数スレッドから積んでも欠け・重複・食い違いがないことを確認
+
+static AppLogRecord record;
+
+void setUp(void)
+{
+    while (app_log_pop(&record)) {
+    }
+}
+
+void tearDown(void)
+{
+}
+
+///////////////////////////////////////
+/// @brief 1件を整形し、"I (時刻) " の後ろを比較する
+static void check_format(const char* expected, const AppLogRecord& r)
+{
+    char line[192];
+    app_log_format(r, line, sizeof(line));
+    const char* message = strchr(line, ')');
+    TEST_ASSERT_NOT_NULL(message);
+    TEST_ASSERT_EQUAL_STRING(expected, message + 2);
+}
+
+#define CHECK_LOG_FORMAT(fmt, ...)                                     \
+    do {                                                               \
+        char expected[192];                                            \
+        snprintf(expected, sizeof(expected), fmt "\n", ##__VA_ARGS__); \
+        app_log_write(APP_LOG_LEVEL_INFO, fmt, ##__VA_ARGS__);         \
+        TEST_ASSERT_TRUE(app_log_pop(&record));                        \
+        check_format(expected, record);                                \
+    } while (0)
+
+static void test_format_matches_snprintf(void)
+{
+    char ssid[WIFI_SSID_SIZE] = "test-ssid";
+
+    CHECK_LOG_FORMAT("plain text 100%%");
+    CHECK_LOG_FORMAT("AP Mode: SSID=%s, IP=%s", ssid, "192.168.4.1");
+    CHECK_LOG_FORMAT("Screen: %s -> %s (%s, %lu us)", "main", "trend", "A short", (unsigned long)123456);
+    CHECK_LOG_FORMAT("%d %u %5.1f %-4s| %02X %c", -42, 42u, 3.14159, "ab", 0xAB, 'z');
+    CHECK_LOG_FORMAT("%lld %llu %zu", -1234567890123LL, 1234567890123ULL, sizeof(AppLogRecord));
+    CHECK_LOG_FORMAT("%.2f %e", 0.125f, 1e-9);
+}
+
+///////////////////////////////////////
+/// @brief レベルと時刻の接頭辞
+static void test_level_prefix(void)
+{
+    app_log_write(APP_LOG_LEVEL_WARN, "warning");
+    TEST_ASSERT_TRUE(app_log_pop(&record));
+
+    char line[64];
+    char expected[64];
+    app_log_format(record, line, sizeof(line));
+    snprintf(expected, sizeof(expected), "W (%lu) warning\n", (unsigned long)record.time_ms);
+    TEST_ASSERT_EQUAL_STRING(expected, line);
+}
+
+///////////////////////////////////////
+/// @brief 引数の領域を超える文字列は切り詰める
+static void test_long_string_truncated(void)
+{
+    char long_text[128];
+    memset(long_text, 'x', sizeof(long_text) - 1);
+    long_text[sizeof(long_text) - 1] = '\0';
+    app_log_write(APP_LOG_LEVEL_INFO, "%d %s", 7, long_text);
+    TEST_ASSERT_TRUE(app_log_pop(&record));
+
+    char expected[192];
+    snprintf(expected, sizeof(expected), "7 %.*s\n", (int)(APP_LOG_PAYLOAD_SIZE - 4 - 1), long_text);
+    check_format(expected, record);
+}
+
+///////////////////////////////////////
+/// @brief バイナリのフレーム（support/log_decode.py が読む形式）
+static void test_encode_frame(void)
+{
+    app_log_write(APP_LOG_LEVEL_INFO, "%d %s", -2, "ab");
+    TEST_ASSERT_TRUE(app_log_pop(&record));
+
+    uint8_t frame[128];
+    size_t length = app_log_encode(record, frame, sizeof(frame));
+    // ヘッダー12 + 型2 + int32 4 + 文字列(長さ1+本文2)
+    TEST_ASSERT_EQUAL_size_t(12 + 2 + 4 + 3, length);
+    TEST_ASSERT_EQUAL_UINT8(0xA5, frame[0]);
+    TEST_ASSERT_EQUAL_UINT8(length - 2, frame[1]);
+    TEST_ASSERT_EQUAL_UINT8(APP_LOG_LEVEL_INFO, frame[10]);
+    TEST_ASSERT_EQUAL_UINT8(2, frame[11]);
+    TEST_ASSERT_EQUAL_UINT8(APP_LOG_ARG_I32, frame[12]);
+    TEST_ASSERT_EQUAL_UINT8(APP_LOG_ARG_STR, frame[13]);
+    TEST_ASSERT_EQUAL_UINT8(2, frame[18]);
+    TEST_ASSERT_EQUAL_MEMORY("ab", frame + 19, 2);
+
+    // 出力先が足りなければ書かない
+    TEST_ASSERT_EQUAL_size_t(0, app_log_encode(record, frame, length - 1));
+}
+
+///////////////////////////////////////
+/// @brief 満杯なら待たずに捨てて数える
+static void test_full_ring_drops(void)
+{
+    uint32_t dropped_before = app_log_get_dropped();
+    for (uint32_t i = 0; i < APP_LOG_SLOTS + 3; i++) {
+        app_log_write(APP_LOG_LEVEL_INFO, "fill %u", i);
+    }
+    TEST_ASSERT_EQUAL_UINT32(3, app_log_get_dropped() - dropped_before);
+
+    uint32_t popped = 0;
+    while (app_log_pop(&record)) {
+        popped++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(APP_LOG_SLOTS, popped);
+}
+
+///////////////////////////////////////
+/// @brief 複数スレッドから積み、1スレッドで取り出す
+/// 書き込み側はリングの半分までに抑え、取りこぼし・食い違い・順序の逆転がないことを確認
+static void test_concurrent_writers(void)
+{
+    static const int WRITERS         = 3;
+    static const uint32_t PER_WRITER = 20000;
+    uint32_t dropped_before          = app_log_get_dropped();
+    std::atomic<int> running(WRITERS);
+    std::atomic<uint32_t> sent(0);
+    std::atomic<uint32_t> received(0);
+    uint32_t mismatched    = 0;
+    uint32_t last[WRITERS] = {};
+    uint32_t out_of_order  = 0;
+    std::thread threads[WRITERS];
+    for (int w = 0; w < WRITERS; w++) {
+        threads[w] = std::thread([&, w]() {
+            for (uint32_t n = 1; n <= PER_WRITER; n++) {
+                while (APP_LOG_SLOTS / 2 <= sent.load() - received.load()) {
+                    std::this_thread::yield();
+                }
+                sent++;
+                app_log_write(APP_LOG_LEVEL_INFO, "writer %d seq %u check %u", w, n, n * 7 + (uint32_t)w);
+            }
+            running--;
+        });
+    }
+    while (true) {
+        bool idle = 0 == running.load();
+        while (app_log_pop(&record)) {
+            int32_t w;
+            uint32_t n;
+            uint32_t c;
+            memcpy(&w, record.payload, 4);
+            memcpy(&n, record.payload + 4, 4);
+            memcpy(&c, record.payload + 8, 4);
+            if (3 != record.nargs || w < 0 || WRITERS <= w || c != n * 7 + (uint32_t)w) {
+                mismatched++;
+                continue;
+            }
+            if (n <= last[w]) {
+                out_of_order++;
+            }
+            last[w] = n;
+            received++;
+        }
+        if (idle) {
+            break;
+        }
+    }
+    for (int w = 0; w < WRITERS; w++) {
+        threads[w].join();
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, mismatched);
+    TEST_ASSERT_EQUAL_UINT32(0, out_of_order);
+    TEST_ASSERT_EQUAL_UINT32(0, app_log_get_dropped() - dropped_before);
+    TEST_ASSERT_EQUAL_UINT32(WRITERS * PER_WRITER, received.load());
+}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_format_matches_snprintf);
+    RUN_TEST(test_level_prefix);
+    RUN_TEST(test_long_string_truncated);
+    RUN_TEST(test_encode_frame);
+    RUN_TEST(test_full_ring_drops);
+    RUN_TEST(test_concurrent_writers);
+    return UNITY_END();
+}
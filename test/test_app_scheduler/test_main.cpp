@@ -0,0 +1,153 @@
+#include <unity.h>
+
+#include "app_scheduler.hpp"
+
+// 周期ジョブのスケジューラーの検証（期限・次の待ち時間・取りこぼしの数え方）
+
+static const uint32_t MAX_WAIT_MS = 1000;
+
+static uint32_t runs_a = 0;
+static uint32_t runs_b = 0;
+
+static void job_a(void)
+{
+    runs_a++;
+}
+
+static void job_b(void)
+{
+    runs_b++;
+}
+
+void setUp(void)
+{
+    runs_a = 0;
+    runs_b = 0;
+}
+
+void tearDown(void)
+{
+}
+
+///////////////////////////////////////
+/// @brief 登録直後に1回実行し、以降は周期ごとに実行して次の期限までの時間を返す
+static void test_runs_on_period(void)
+{
+    AppScheduler scheduler;
+    int job = scheduler.add("a", job_a, 100, 0);
+    TEST_ASSERT_EQUAL_INT(0, job);
+
+    TEST_ASSERT_EQUAL_UINT32(100, scheduler.runDue(0, MAX_WAIT_MS));
+    TEST_ASSERT_EQUAL_UINT32(1, runs_a);
+    TEST_ASSERT_EQUAL_UINT32(60, scheduler.runDue(40, MAX_WAIT_MS));
+    TEST_ASSERT_EQUAL_UINT32(1, runs_a);
+    TEST_ASSERT_EQUAL_UINT32(100, scheduler.runDue(100, MAX_WAIT_MS));
+    TEST_ASSERT_EQUAL_UINT32(2, runs_a);
+
+    // 期限から少し遅れても位相は保つ
+    TEST_ASSERT_EQUAL_UINT32(70, scheduler.runDue(230, MAX_WAIT_MS));
+    TEST_ASSERT_EQUAL_UINT32(3, runs_a);
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.getStats(job).overruns);
+    TEST_ASSERT_EQUAL_UINT32(30, scheduler.getStats(job).late_max);
+}
+
+///////////////////////////////////////
+/// @brief 1周期以上遅れたら逃した周期を取りこぼしとして数え、1回だけ実行する
+static void test_overrun_skips_missed_periods(void)
+{
+    AppScheduler scheduler;
+    int job = scheduler.add("a", job_a, 100, 0);
+    scheduler.runDue(0, MAX_WAIT_MS);
+
+    // 期限100から350まで遅れた：200・300 の2周期を逃し、次の期限は400
+    TEST_ASSERT_EQUAL_UINT32(50, scheduler.runDue(350, MAX_WAIT_MS));
+    TEST_ASSERT_EQUAL_UINT32(2, runs_a);
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.getStats(job).overruns);
+    TEST_ASSERT_EQUAL_UINT32(250, scheduler.getStats(job).late_max);
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.getStats(job).runs);
+
+    TEST_ASSERT_EQUAL_UINT32(100, scheduler.runDue(400, MAX_WAIT_MS));
+    TEST_ASSERT_EQUAL_UINT32(3, runs_a);
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.getStats(job).overruns);
+}
+
+///////////////////////////////////////
+/// @brief 次の待ち時間は最も近い期限、実行するジョブがなければ max_wait_ms
+static void test_next_wake_is_earliest_deadline(void)
+{
+    AppScheduler scheduler;
+    int a = scheduler.add("a", job_a, 100, 0);
+    int b = scheduler.add("b", job_b, 30, 0);
+
+    TEST_ASSERT_EQUAL_UINT32(30, scheduler.runDue(0, MAX_WAIT_MS));
+    TEST_ASSERT_EQUAL_UINT32(10, scheduler.runDue(20, 10));  // max_wait_ms で打ち切り
+    TEST_ASSERT_EQUAL_UINT32(30, scheduler.runDue(30, MAX_WAIT_MS));
+    TEST_ASSERT_EQUAL_UINT32(1, runs_a);
+    TEST_ASSERT_EQUAL_UINT32(2, runs_b);
+
+    scheduler.setPeriod(a, 0, 30, false);
+    scheduler.setPeriod(b, 0, 30, false);
+    TEST_ASSERT_EQUAL_UINT32(MAX_WAIT_MS, scheduler.runDue(1000, MAX_WAIT_MS));
+    TEST_ASSERT_EQUAL_UINT32(1, runs_a);
+    TEST_ASSERT_EQUAL_UINT32(2, runs_b);
+}
+
+///////////////////////////////////////
+/// @brief 周期の変更は now_ms から数え直す（run_now なら次の runDue() で実行）
+static void test_set_period(void)
+{
+    AppScheduler scheduler;
+    int job = scheduler.add("a", job_a, 100, 0);
+    scheduler.runDue(0, MAX_WAIT_MS);
+
+    scheduler.setPeriod(job, 500, 50, false);
+    TEST_ASSERT_EQUAL_UINT32(450, scheduler.runDue(100, MAX_WAIT_MS));
+    TEST_ASSERT_EQUAL_UINT32(1, runs_a);
+
+    scheduler.setPeriod(job, 500, 200, true);
+    TEST_ASSERT_EQUAL_UINT32(500, scheduler.runDue(200, MAX_WAIT_MS));
+    TEST_ASSERT_EQUAL_UINT32(2, runs_a);
+}
+
+///////////////////////////////////////
+/// @brief 時刻の桁あふれをまたいでも期限を判定できる
+static void test_clock_wraparound(void)
+{
+    AppScheduler scheduler;
+    const uint32_t start = 0xFFFFFFFFUL - 49;
+    int job = scheduler.add("a", job_a, 100, start);
+
+    TEST_ASSERT_EQUAL_UINT32(100, scheduler.runDue(start, MAX_WAIT_MS));
+    TEST_ASSERT_EQUAL_UINT32(40, scheduler.runDue(start + 60, MAX_WAIT_MS));
+    TEST_ASSERT_EQUAL_UINT32(1, runs_a);
+    TEST_ASSERT_EQUAL_UINT32(100, scheduler.runDue(start + 100, MAX_WAIT_MS));
+    TEST_ASSERT_EQUAL_UINT32(2, runs_a);
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.getStats(job).overruns);
+}
+
+///////////////////////////////////////
+/// @brief 登録数の上限と不正な引数
+static void test_add_limits(void)
+{
+    AppScheduler scheduler;
+    TEST_ASSERT_EQUAL_INT(-1, scheduler.add("null", nullptr, 100, 0));
+    for (int i = 0; i < AppScheduler::MAX_JOBS; i++) {
+        TEST_ASSERT_EQUAL_INT(i, scheduler.add("a", job_a, 100, 0));
+    }
+    TEST_ASSERT_EQUAL_INT(-1, scheduler.add("a", job_a, 100, 0));
+
+    scheduler.runDue(0, MAX_WAIT_MS);
+    TEST_ASSERT_EQUAL_UINT32(AppScheduler::MAX_JOBS, runs_a);
+}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_runs_on_period);
+    RUN_TEST(test_overrun_skips_missed_periods);
+    RUN_TEST(test_next_wake_is_earliest_deadline);
+    RUN_TEST(test_set_period);
+    RUN_TEST(test_clock_wraparound);
+    RUN_TEST(test_add_limits);
+    return UNITY_END();
+}
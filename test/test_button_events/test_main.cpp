@@ -0,0 +1,131 @@
+#include <unity.h>
+
+#include "button_events.hpp"
+
+// ボタンのデバウンスとイベントキューの検証
+
+static const uint8_t A = ButtonEvent::A;
+static const uint8_t B = ButtonEvent::B;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static void check_event(ButtonEvents& events, uint8_t button, bool pressed, uint32_t time_ms)
+{
+    ButtonEvent event;
+    TEST_ASSERT_TRUE(events.pop(&event));
+    TEST_ASSERT_EQUAL_UINT8(button, event.button);
+    TEST_ASSERT_EQUAL(pressed, event.pressed);
+    TEST_ASSERT_EQUAL_UINT32(time_ms, event.time_ms);
+}
+
+///////////////////////////////////////
+/// @brief 採用したエッジから DEBOUNCE_MS 以内の変化はチャタリングとして捨てる
+static void test_bounce_is_dropped(void)
+{
+    ButtonEvents events;
+    events.onEdge(A, true, 100);
+    events.onEdge(A, false, 105);  // チャタリング
+    events.onEdge(A, true, 110);   // レベルが変わっていない
+    events.onEdge(A, false, 100 + ButtonEvents::DEBOUNCE_MS);
+
+    check_event(events, A, true, 100);
+    check_event(events, A, false, 100 + ButtonEvents::DEBOUNCE_MS);
+    ButtonEvent event;
+    TEST_ASSERT_FALSE(events.pop(&event));
+    TEST_ASSERT_FALSE(events.isPressed(A));
+}
+
+///////////////////////////////////////
+/// @brief ボタンごとに独立してデバウンスする
+static void test_buttons_are_independent(void)
+{
+    ButtonEvents events;
+    events.onEdge(A, true, 100);
+    events.onEdge(B, true, 101);
+
+    check_event(events, A, true, 100);
+    check_event(events, B, true, 101);
+    TEST_ASSERT_TRUE(events.isPressed(A));
+    TEST_ASSERT_TRUE(events.isPressed(B));
+}
+
+///////////////////////////////////////
+/// @brief デバウンス期間中に捨てた最後のエッジを sync() が補う
+static void test_sync_recovers_dropped_edge(void)
+{
+    ButtonEvents events;
+    events.onEdge(A, true, 1000);
+    events.onEdge(A, false, 1010);  // 本当の解放だがデバウンス期間中
+    TEST_ASSERT_TRUE(events.isPressed(A));
+
+    events.sync(A, false, 1015);  // まだデバウンス期間中
+    TEST_ASSERT_TRUE(events.isPressed(A));
+    events.sync(A, false, 1000 + ButtonEvents::DEBOUNCE_MS);
+    TEST_ASSERT_FALSE(events.isPressed(A));
+
+    check_event(events, A, true, 1000);
+    check_event(events, A, false, 1000 + ButtonEvents::DEBOUNCE_MS);
+}
+
+///////////////////////////////////////
+/// @brief レベルが一致していれば sync() はイベントを積まない
+static void test_sync_without_change(void)
+{
+    ButtonEvents events;
+    events.sync(A, false, 1000);
+    events.onEdge(A, true, 2000);
+    events.sync(A, true, 3000);
+
+    check_event(events, A, true, 2000);
+    ButtonEvent event;
+    TEST_ASSERT_FALSE(events.pop(&event));
+}
+
+///////////////////////////////////////
+/// @brief キューがあふれたら新しいイベントを捨てて数える
+static void test_queue_overflow(void)
+{
+    ButtonEvents events;
+    const uint32_t edges = ButtonEvents::QUEUE_SIZE + 4;
+    for (uint32_t i = 0; i < edges; i++) {
+        events.onEdge(A, 0 == (i & 1), 100 + i * 100);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(edges - (ButtonEvents::QUEUE_SIZE - 1), events.getDropped());
+    for (uint32_t i = 0; i < ButtonEvents::QUEUE_SIZE - 1; i++) {
+        check_event(events, A, 0 == (i & 1), 100 + i * 100);
+    }
+    ButtonEvent event;
+    TEST_ASSERT_FALSE(events.pop(&event));
+}
+
+///////////////////////////////////////
+/// @brief 範囲外のボタン番号は無視する
+static void test_invalid_button(void)
+{
+    ButtonEvents events;
+    events.onEdge(ButtonEvents::MAX_BUTTONS, true, 100);
+    events.sync(ButtonEvents::MAX_BUTTONS, true, 200);
+
+    ButtonEvent event;
+    TEST_ASSERT_FALSE(events.pop(&event));
+    TEST_ASSERT_FALSE(events.isPressed(ButtonEvents::MAX_BUTTONS));
+}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_bounce_is_dropped);
+    RUN_TEST(test_buttons_are_independent);
+    RUN_TEST(test_sync_recovers_dropped_edge);
+    RUN_TEST(test_sync_without_change);
+    RUN_TEST(test_queue_overflow);
+    RUN_TEST(test_invalid_button);
+    return UNITY_END();
+}
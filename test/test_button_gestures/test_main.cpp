@@ -0,0 +1,139 @@
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+
+#include "button_gestures.hpp"
+
+// ボタン操作の認識の検証
+// 時刻付きのボタンイベント列を与え、認識した操作の列が期待どおりか
+
+// 操作: 'p'=押下, 'r'=解放, 'u'=update(), 'x'=reset()
+struct Step {
+    char op;
+    uint8_t button;
+    uint32_t time_ms;
+};
+
+static const uint8_t A = ButtonEvent::A;
+static const uint8_t B = ButtonEvent::B;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+///////////////////////////////////////
+/// @brief イベント列を与えて認識した操作を "種類(S/L/D/C/R) + ボタン(A/B) + 時刻" の列にする
+static void run_steps(const Step* steps, size_t count, uint32_t double_ms, uint32_t repeat_ms, char* result,
+                      size_t size)
+{
+    static const char TYPE_CHARS[] = {'S', 'L', 'D', 'C', 'R'};
+
+    ButtonGestures gestures;
+    ButtonGestures::Config config;
+    config.long_ms[A] = 1500;
+    config.long_ms[B] = 3000;
+    config.double_ms  = double_ms;
+    config.repeat_ms  = repeat_ms;
+    gestures.configure(config);
+
+    size_t len = 0;
+    result[0]  = '\0';
+    for (size_t i = 0; i < count; i++) {
+        const Step& step = steps[i];
+        if ('u' == step.op) {
+            gestures.update(step.time_ms);
+        } else if ('x' == step.op) {
+            gestures.reset();
+        } else {
+            ButtonEvent event = {step.time_ms, step.button, 'p' == step.op};
+            gestures.onEvent(event);
+        }
+        Gesture g;
+        while (gestures.pop(&g) && len + 16 < size) {
+            len += snprintf(result + len, size - len, "%s%c%c%u", (0 < len) ? " " : "", TYPE_CHARS[(int)g.type],
+                            (A == g.button) ? 'A' : 'B', (unsigned)g.time_ms);
+        }
+    }
+}
+
+#define CHECK_GESTURES(expected, double_ms, repeat_ms, ...)                                    \
+    do {                                                                                       \
+        static const Step steps[] = {__VA_ARGS__};                                             \
+        char result[128];                                                                      \
+        run_steps(steps, sizeof(steps) / sizeof(steps[0]), double_ms, repeat_ms, result, 128); \
+        TEST_ASSERT_EQUAL_STRING(expected, result);                                            \
+    } while (0)
+
+static void test_short(void)
+{
+    CHECK_GESTURES("SA100", 0, 0, {'p', A, 0}, {'r', A, 100});
+}
+
+static void test_long(void)
+{
+    CHECK_GESTURES("LA1500", 0, 0, {'p', A, 0}, {'u', 0, 1499}, {'u', 0, 1500}, {'r', A, 2000});
+}
+
+static void test_long_late_update(void)
+{
+    // update() が遅れても長押しの時刻は押下から long_ms 後
+    CHECK_GESTURES("LB3000", 0, 0, {'p', B, 0}, {'r', B, 3200});
+}
+
+static void test_chord(void)
+{
+    CHECK_GESTURES("CB40", 0, 0, {'p', A, 0}, {'p', B, 40}, {'u', 0, 5000}, {'r', A, 5100}, {'r', B, 5200});
+}
+
+static void test_chord_after_long(void)
+{
+    CHECK_GESTURES("LA1500 SB1700", 0, 0, {'p', A, 0}, {'u', 0, 1500}, {'p', B, 1600}, {'r', B, 1700});
+}
+
+static void test_double(void)
+{
+    CHECK_GESTURES("DA200", 300, 0, {'p', A, 0}, {'r', A, 80}, {'p', A, 200}, {'r', A, 280}, {'u', 0, 1000});
+}
+
+static void test_double_timeout(void)
+{
+    CHECK_GESTURES("SA80", 300, 0, {'p', A, 0}, {'r', A, 80}, {'u', 0, 380}, {'u', 0, 381});
+}
+
+static void test_double_late_press(void)
+{
+    CHECK_GESTURES("SA80 SA600", 300, 0, {'p', A, 0}, {'r', A, 80}, {'p', A, 500}, {'r', A, 600}, {'u', 0, 901});
+}
+
+static void test_repeat(void)
+{
+    CHECK_GESTURES("LA1500 RA1700 RA1900", 0, 200, {'p', A, 0}, {'u', 0, 1500}, {'u', 0, 1700}, {'u', 0, 1800},
+                   {'u', 0, 1900});
+}
+
+static void test_reset_while_held(void)
+{
+    // reset() 時に押されていたボタンは離すまで無視
+    CHECK_GESTURES("SA2300", 0, 0, {'p', A, 0}, {'x', 0, 100}, {'u', 0, 2000}, {'r', A, 2100}, {'p', A, 2200},
+                   {'r', A, 2300});
+}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_short);
+    RUN_TEST(test_long);
+    RUN_TEST(test_long_late_update);
+    RUN_TEST(test_chord);
+    RUN_TEST(test_chord_after_long);
+    RUN_TEST(test_double);
+    RUN_TEST(test_double_timeout);
+    RUN_TEST(test_double_late_press);
+    RUN_TEST(test_repeat);
+    RUN_TEST(test_reset_while_held);
+    return UNITY_END();
+}
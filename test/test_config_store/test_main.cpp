@@ -0,0 +1,142 @@
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+
+#include "config_store.hpp"
+
+// 設定ストアの検証
+// 変更がまとめて1回だけ書き込まれること、読み戻せること、壊れた・版数違いのデータを捨てることを確認
+
+// 保存先（メモリ上）
+static uint8_t blob[256];
+static size_t blob_size    = 0;
+static uint32_t blob_saves = 0;
+
+static AppConfig defaults;
+
+static size_t load_blob(void* data, size_t size)
+{
+    if (blob_size != size) {
+        return 0;
+    }
+    memcpy(data, blob, size);
+    return size;
+}
+
+static bool save_blob(const void* data, size_t size)
+{
+    if (sizeof(blob) < size) {
+        return false;
+    }
+    memcpy(blob, data, size);
+    blob_size = size;
+    blob_saves++;
+    return true;
+}
+
+void setUp(void)
+{
+    blob_size  = 0;
+    blob_saves = 0;
+    memset(&defaults, 0, sizeof(defaults));
+    defaults.display.brightness = 200;
+}
+
+void tearDown(void)
+{
+}
+
+///////////////////////////////////////
+/// @brief 保存されていなければ既定値から始める
+static void test_empty_storage_uses_defaults(void)
+{
+    ConfigStore store;
+    TEST_ASSERT_FALSE(store.begin(load_blob, save_blob, defaults));
+    TEST_ASSERT_EQUAL_UINT8(200, store.get().display.brightness);
+    TEST_ASSERT_FALSE(store.isDirty());
+}
+
+///////////////////////////////////////
+/// @brief 連続した変更は最後の変更から COALESCE_MS 後に1回だけ書き込む
+static void test_edits_are_coalesced(void)
+{
+    ConfigStore store;
+    store.begin(load_blob, save_blob, defaults);
+    for (uint32_t i = 0; i < 5; i++) {
+        store.edit(i * 100).display.brightness += 10;
+    }
+    TEST_ASSERT_FALSE(store.flush(400 + ConfigStore::COALESCE_MS - 1));
+    TEST_ASSERT_TRUE(store.flush(400 + ConfigStore::COALESCE_MS));
+    TEST_ASSERT_EQUAL_UINT32(1, blob_saves);
+    TEST_ASSERT_FALSE(store.isDirty());
+    TEST_ASSERT_EQUAL_UINT32(1, store.getStats().writes);
+    TEST_ASSERT_EQUAL_UINT32(5, store.getStats().edits);
+}
+
+///////////////////////////////////////
+/// @brief 内容が保存済みと同じなら書き込まない
+static void test_unchanged_content_not_written(void)
+{
+    ConfigStore store;
+    store.begin(load_blob, save_blob, defaults);
+    store.edit(0).display.brightness = 100;
+    TEST_ASSERT_TRUE(store.flushNow());
+
+    store.edit(10000).display.brightness = 100;
+    TEST_ASSERT_FALSE(store.flushNow());
+    TEST_ASSERT_EQUAL_UINT32(1, blob_saves);
+    TEST_ASSERT_EQUAL_UINT32(1, store.getStats().unchanged);
+}
+
+///////////////////////////////////////
+/// @brief 書き込んだ内容を読み戻せる
+static void test_reload_round_trip(void)
+{
+    ConfigStore store;
+    store.begin(load_blob, save_blob, defaults);
+    snprintf(store.edit(0).wifi.ssid, WIFI_SSID_SIZE, "%s", "test-ssid");
+    store.edit(0).calibration.scale = 27.5f;
+    TEST_ASSERT_TRUE(store.flushNow());
+
+    ConfigStore reloaded;
+    TEST_ASSERT_TRUE(reloaded.begin(load_blob, save_blob, defaults));
+    TEST_ASSERT_EQUAL_MEMORY(&store.get(), &reloaded.get(), sizeof(AppConfig));
+    TEST_ASSERT_EQUAL_STRING("test-ssid", reloaded.get().wifi.ssid);
+}
+
+///////////////////////////////////////
+/// @brief ペイロードの1ビット反転（CRC不一致）・版数違いは既定値に戻す
+static void test_corrupted_or_old_version_rejected(void)
+{
+    ConfigStore store;
+    store.begin(load_blob, save_blob, defaults);
+    snprintf(store.edit(0).wifi.ssid, WIFI_SSID_SIZE, "%s", "test-ssid");
+    TEST_ASSERT_TRUE(store.flushNow());
+
+    blob[blob_size - 1] ^= 0x01;
+    ConfigStore corrupted;
+    TEST_ASSERT_FALSE(corrupted.begin(load_blob, save_blob, defaults));
+    TEST_ASSERT_EQUAL_UINT8(200, corrupted.get().display.brightness);
+    TEST_ASSERT_EQUAL_CHAR('\0', corrupted.get().wifi.ssid[0]);
+    blob[blob_size - 1] ^= 0x01;
+
+    // ヘッダーの magic の直後
+    blob[4] ^= 0xFF;
+    ConfigStore old_version;
+    TEST_ASSERT_FALSE(old_version.begin(load_blob, save_blob, defaults));
+    blob[4] ^= 0xFF;
+
+    ConfigStore restored;
+    TEST_ASSERT_TRUE(restored.begin(load_blob, save_blob, defaults));
+}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_storage_uses_defaults);
+    RUN_TEST(test_edits_are_coalesced);
+    RUN_TEST(test_unchanged_content_not_written);
+    RUN_TEST(test_reload_round_trip);
+    RUN_TEST(test_corrupted_or_old_version_rejected);
+    return UNITY_END();
+}
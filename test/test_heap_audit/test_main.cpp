@@ -0,0 +1,135 @@
+#include <stdlib.h>
+#include <string.h>
+#include <unity.h>
+
+#include "heap_audit.hpp"
+
+// ヒープ監査の検証（静的メモリモード、native 環境は APP_STATIC_MEMORY=1 と malloc の --wrap でビルドする）
+// 定常状態での確保を operator new だけでなく C のアロケーター経由でも数えること
+
+static HeapAuditStats before;
+static char* volatile sink;  // 確保した領域を外へ逃がし、確保と解放の組を最適化で消させない
+
+///////////////////////////////////////
+/// @brief Arduino の String と同じく malloc 系で確保する一時文字列
+/// （WString.cpp の changeBuffer() は realloc で伸ばし、デストラクターで free する）
+class TempString {
+public:
+    explicit TempString(const char* text) : buffer(nullptr), length(0)
+    {
+        append(text);
+    }
+
+    ~TempString()
+    {
+        free(buffer);
+    }
+
+    TempString& operator+=(const char* text)
+    {
+        append(text);
+        return *this;
+    }
+
+    const char* c_str(void) const
+    {
+        return buffer;
+    }
+
+private:
+    void append(const char* text)
+    {
+        size_t add = strlen(text);
+        buffer     = (char*)realloc(buffer, length + add + 1);
+        memcpy(buffer + length, text, add + 1);
+        length += add;
+        sink = buffer;
+    }
+
+    char* buffer;
+    size_t length;
+};
+
+void setUp(void)
+{
+    heap_audit_mark_steady();
+    heap_audit_set_exempt(false);
+    heap_audit_get(&before);
+}
+
+void tearDown(void)
+{
+    heap_audit_set_exempt(false);
+}
+
+///////////////////////////////////////
+/// @brief setup() 後に String の一時オブジェクトを作ると定常状態の確保として数える
+static void test_string_temporary_is_counted(void)
+{
+#if APP_STATIC_MEMORY
+    {
+        TempString weight("weight: ");
+        weight += "12.34";
+        TEST_ASSERT_EQUAL_STRING("weight: 12.34", weight.c_str());
+    }
+
+    HeapAuditStats now;
+    heap_audit_get(&now);
+    TEST_ASSERT_EQUAL_UINT32(2, now.steady_allocs - before.steady_allocs);
+    TEST_ASSERT_EQUAL_UINT32(1, now.frees - before.frees);
+#else
+    TEST_IGNORE_MESSAGE("APP_STATIC_MEMORY=1 でビルドしたときだけ数える");
+#endif
+}
+
+///////////////////////////////////////
+/// @brief malloc / calloc / free と operator new / delete をそれぞれ1回ずつ数える
+static void test_each_allocator_counted_once(void)
+{
+#if APP_STATIC_MEMORY
+    sink = (char*)malloc(16);
+    free(sink);
+    sink = (char*)calloc(4, 8);
+    free(sink);
+    int* value = new int(7);
+    sink       = (char*)value;
+    delete value;
+
+    HeapAuditStats now;
+    heap_audit_get(&now);
+    TEST_ASSERT_EQUAL_UINT32(3, now.steady_allocs - before.steady_allocs);
+    TEST_ASSERT_EQUAL_UINT32(16 + 32 + sizeof(int), now.steady_bytes - before.steady_bytes);
+    TEST_ASSERT_EQUAL_UINT32(3, now.frees - before.frees);
+#else
+    TEST_IGNORE_MESSAGE("APP_STATIC_MEMORY=1 でビルドしたときだけ数える");
+#endif
+}
+
+///////////////////////////////////////
+/// @brief 除外中の確保は定常状態の確保に含めない
+static void test_exempt_allocations(void)
+{
+#if APP_STATIC_MEMORY
+    heap_audit_set_exempt(true);
+    {
+        TempString page("<html>");
+    }
+    heap_audit_set_exempt(false);
+
+    HeapAuditStats now;
+    heap_audit_get(&now);
+    TEST_ASSERT_EQUAL_UINT32(0, now.steady_allocs - before.steady_allocs);
+    TEST_ASSERT_EQUAL_UINT32(1, now.exempt_allocs - before.exempt_allocs);
+#else
+    TEST_IGNORE_MESSAGE("APP_STATIC_MEMORY=1 でビルドしたときだけ数える");
+#endif
+}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_string_temporary_is_counted);
+    RUN_TEST(test_each_allocator_counted_once);
+    RUN_TEST(test_exempt_allocations);
+    return UNITY_END();
+}
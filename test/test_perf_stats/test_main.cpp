@@ -0,0 +1,101 @@
+#include <unity.h>
+
+#include "lvgl_perf_stats.hpp"
+
+// 描画性能の集計の検証（同期フラッシュとDMAの非同期フラッシュでの時間の分け方）
+
+static PerfStats stats;
+static PerfStats::Window window;
+
+void setUp(void)
+{
+    stats = PerfStats();
+}
+
+void tearDown(void)
+{
+}
+
+///////////////////////////////////////
+/// @brief 同期フラッシュ：フラッシュ関数内の時間をフラッシュ時間とし、残りを描画時間とする
+static void test_sync_flush(void)
+{
+    stats.frameStart(1000);
+    stats.flushDone(200, 300);
+    stats.flushDone(5000, 500);
+    stats.frameEnd(3000);
+
+    TEST_ASSERT_TRUE(stats.roll(1000, 1000, &window));
+    TEST_ASSERT_EQUAL_UINT32(1, window.frames);
+    TEST_ASSERT_EQUAL_UINT32(1200, window.render_us_total);
+    TEST_ASSERT_EQUAL_UINT32(800, window.flush_us_total);
+    TEST_ASSERT_EQUAL_UINT32(800, window.flush_us_max);
+    TEST_ASSERT_EQUAL_UINT32(2, window.flushes);
+    TEST_ASSERT_EQUAL_UINT32(1, window.area_hist[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, window.area_hist[3]);
+}
+
+///////////////////////////////////////
+/// @brief 非同期フラッシュ：フラッシュ時間は最初の転送開始から最後の転送完了まで
+static void test_async_flush_counts_until_transfer_done(void)
+{
+    stats.frameStart(1000);
+    stats.flushQueued(4000, 1500, 50);   // 最初の転送を開始
+    stats.flushQueued(4000, 2500, 400);  // 前の転送の完了を 400us 待った
+    stats.frameEnd(3000);
+    stats.transferDone(4200);
+
+    TEST_ASSERT_TRUE(stats.roll(1000, 1000, &window));
+    TEST_ASSERT_EQUAL_UINT32(1, window.frames);
+    TEST_ASSERT_EQUAL_UINT32(2000 - 450, window.render_us_total);
+    TEST_ASSERT_EQUAL_UINT32(4200 - 1500, window.flush_us_total);
+    TEST_ASSERT_EQUAL_UINT32(4200 - 1500, window.flush_us_max);
+    TEST_ASSERT_EQUAL_UINT32(2, window.flushes);
+}
+
+///////////////////////////////////////
+/// @brief 転送の完了は1フレームに1回だけ数え、次のフレームは新しい転送開始から数える
+static void test_async_transfer_done_once_per_frame(void)
+{
+    stats.frameStart(0);
+    stats.flushQueued(100, 100, 0);
+    stats.frameEnd(200);
+    stats.transferDone(1000);
+    stats.transferDone(5000);  // 転送中でなければ無視
+
+    stats.frameStart(10000);
+    stats.flushQueued(100, 10100, 0);
+    stats.frameEnd(10200);
+    stats.transferDone(10400);
+
+    TEST_ASSERT_TRUE(stats.roll(1000, 1000, &window));
+    TEST_ASSERT_EQUAL_UINT32(2, window.frames);
+    TEST_ASSERT_EQUAL_UINT32(900 + 300, window.flush_us_total);
+    TEST_ASSERT_EQUAL_UINT32(900, window.flush_us_max);
+}
+
+///////////////////////////////////////
+/// @brief 窓の区切り：window_ms 未満では区切らず、区切ったら集計を空にする
+static void test_roll_window(void)
+{
+    TEST_ASSERT_FALSE(stats.roll(999, 1000, &window));
+    stats.frameStart(0);
+    stats.frameEnd(100);
+    TEST_ASSERT_TRUE(stats.roll(1000, 1000, &window));
+    TEST_ASSERT_EQUAL_UINT32(1000, window.duration_ms);
+    TEST_ASSERT_EQUAL_UINT32(1, window.frames);
+
+    TEST_ASSERT_TRUE(stats.roll(2500, 1000, &window));
+    TEST_ASSERT_EQUAL_UINT32(1500, window.duration_ms);
+    TEST_ASSERT_EQUAL_UINT32(0, window.frames);
+}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_sync_flush);
+    RUN_TEST(test_async_flush_counts_until_transfer_done);
+    RUN_TEST(test_async_transfer_done_once_per_frame);
+    RUN_TEST(test_roll_window);
+    return UNITY_END();
+}
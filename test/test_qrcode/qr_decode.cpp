@@ -0,0 +1,333 @@
+#include "qr_decode.hpp"
+
+#include <stdint.h>
+#include <string.h>
+
+// 誤り訂正レベル（形式情報のビット値 L=1, M=0, Q=3, H=2 を L,M,Q,H 順の添字へ）
+static const uint8_t ECL_INDEX[4] = {1, 0, 3, 2};
+
+// ブロックあたりの誤り訂正コード語数 [L,M,Q,H][version]
+static const uint8_t ECC_PER_BLOCK[4][QRCodeGenerator::MAX_VERSION + 1] = {
+    {0, 7, 10, 15, 20, 26, 18, 20, 24, 30, 18},
+    {0, 10, 16, 26, 18, 24, 16, 18, 22, 22, 26},
+    {0, 13, 22, 18, 26, 18, 24, 18, 22, 20, 24},
+    {0, 17, 28, 22, 16, 22, 28, 26, 26, 24, 28},
+};
+
+// ブロック数 [L,M,Q,H][version]
+static const uint8_t NUM_BLOCKS[4][QRCodeGenerator::MAX_VERSION + 1] = {
+    {0, 1, 1, 1, 1, 1, 2, 2, 2, 2, 4},
+    {0, 1, 1, 1, 2, 2, 4, 4, 4, 5, 5},
+    {0, 1, 1, 2, 2, 4, 4, 6, 6, 8, 8},
+    {0, 1, 1, 2, 4, 4, 4, 5, 6, 8, 8},
+};
+
+static const int MAX_CODEWORDS = 346;  // バージョン10の総コード語数
+
+///////////////////////////////////////
+// GF(256)（原始多項式 0x11D）
+
+static uint8_t gf_mul(uint8_t a, uint8_t b)
+{
+    uint8_t r = 0;
+    while (b) {
+        if (b & 1) {
+            r ^= a;
+        }
+        a = (uint8_t)((a << 1) ^ ((a & 0x80) ? 0x1D : 0));
+        b >>= 1;
+    }
+    return r;
+}
+
+///////////////////////////////////////
+// 機能パターン
+
+static void mark_rect(bool* function, int size, int x0, int y0, int w, int h)
+{
+    for (int y = y0; y < y0 + h; y++) {
+        for (int x = x0; x < x0 + w; x++) {
+            if (0 <= x && x < size && 0 <= y && y < size) {
+                function[y * size + x] = true;
+            }
+        }
+    }
+}
+
+static void mark_function_patterns(bool* function, int version, int size)
+{
+    memset(function, 0, (size_t)size * size);
+
+    // 位置検出パターン＋分離パターン＋形式情報
+    mark_rect(function, size, 0, 0, 9, 9);
+    mark_rect(function, size, size - 8, 0, 8, 9);
+    mark_rect(function, size, 0, size - 8, 9, 8);
+
+    // タイミングパターン
+    mark_rect(function, size, 6, 0, 1, size);
+    mark_rect(function, size, 0, 6, size, 1);
+
+    // 位置合わせパターン
+    if (2 <= version) {
+        int count = version / 7 + 2;
+        int step  = (version * 4 + count * 2 + 1) / (count * 2 - 2) * 2;
+        int pos[7];
+        pos[0] = 6;
+        for (int i = count - 1, p = size - 7; 1 <= i; i--, p -= step) {
+            pos[i] = p;
+        }
+        for (int i = 0; i < count; i++) {
+            for (int j = 0; j < count; j++) {
+                bool corner = (0 == i && 0 == j) || (0 == i && count - 1 == j) || (count - 1 == i && 0 == j);
+                if (!corner) {
+                    mark_rect(function, size, pos[i] - 2, pos[j] - 2, 5, 5);
+                }
+            }
+        }
+    }
+
+    // バージョン情報
+    if (7 <= version) {
+        mark_rect(function, size, size - 11, 0, 3, 6);
+        mark_rect(function, size, 0, size - 11, 6, 3);
+    }
+}
+
+static bool mask_bit(int mask, int x, int y)
+{
+    switch (mask) {
+        case 0: return 0 == (x + y) % 2;
+        case 1: return 0 == y % 2;
+        case 2: return 0 == x % 3;
+        case 3: return 0 == (x + y) % 3;
+        case 4: return 0 == (x / 3 + y / 2) % 2;
+        case 5: return 0 == x * y % 2 + x * y % 3;
+        case 6: return 0 == (x * y % 2 + x * y % 3) % 2;
+        default: return 0 == ((x + y) % 2 + x * y % 3) % 2;
+    }
+}
+
+///////////////////////////////////////
+// 形式情報
+
+static uint32_t format_codeword(uint32_t data)
+{
+    uint32_t rem = data;
+    for (int i = 0; i < 10; i++) {
+        rem = (rem << 1) ^ ((rem >> 9) * 0x537);
+    }
+    return ((data << 10) | (rem & 0x3FF)) ^ 0x5412;
+}
+
+static bool read_format(const QRCodeGenerator::Matrix& qrcode, int* ecl, int* mask)
+{
+    uint32_t bits = 0;
+    for (int i = 0; i <= 5; i++) {
+        bits |= (uint32_t)qrcode.get(8, i) << i;
+    }
+    bits |= (uint32_t)qrcode.get(8, 7) << 6;
+    bits |= (uint32_t)qrcode.get(8, 8) << 7;
+    bits |= (uint32_t)qrcode.get(7, 8) << 8;
+    for (int i = 9; i < 15; i++) {
+        bits |= (uint32_t)qrcode.get(14 - i, 8) << i;
+    }
+
+    for (uint32_t data = 0; data < 32; data++) {
+        if (format_codeword(data) == bits) {
+            *ecl  = ECL_INDEX[data >> 3];
+            *mask = (int)(data & 7);
+            return true;
+        }
+    }
+    return false;
+}
+
+///////////////////////////////////////
+// データ部の復号
+
+struct BitReader {
+    const uint8_t* data;
+    int length;  // [bit]
+    int pos;
+
+    int read(int n)
+    {
+        if (length < pos + n) {
+            return -1;
+        }
+        int v = 0;
+        for (int i = 0; i < n; i++, pos++) {
+            v = (v << 1) | ((data[pos >> 3] >> (7 - (pos & 7))) & 1);
+        }
+        return v;
+    }
+};
+
+static const char ALNUM_CHARSET[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:";
+
+static int decode_segments(BitReader& reader, int version, char* out, size_t out_size)
+{
+    size_t len = 0;
+    while (true) {
+        int mode = reader.read(4);
+        if (mode <= 0) {
+            break;  // 終端パターン（またはデータ末尾）
+        }
+
+        int count_bits = (mode == 1) ? 10 : (mode == 2) ? 9 : (mode == 4) ? 8 : 0;
+        if (0 == count_bits) {
+            return -1;  // 未対応モード
+        }
+        if (10 <= version) {
+            count_bits = (mode == 1) ? 12 : (mode == 2) ? 11 : 16;
+        }
+        int count = reader.read(count_bits);
+        if (count < 0 || out_size <= len + count) {
+            return -1;
+        }
+
+        if (mode == 4) {
+            for (int i = 0; i < count; i++) {
+                int c = reader.read(8);
+                if (c < 0) {
+                    return -1;
+                }
+                out[len++] = (char)c;
+            }
+        } else if (mode == 2) {
+            for (int i = 0; i < count; i += 2) {
+                int pair = (i + 1 < count);
+                int v    = reader.read(pair ? 11 : 6);
+                if (v < 0) {
+                    return -1;
+                }
+                if (pair) {
+                    out[len++] = ALNUM_CHARSET[v / 45];
+                    out[len++] = ALNUM_CHARSET[v % 45];
+                } else {
+                    out[len++] = ALNUM_CHARSET[v];
+                }
+            }
+        } else {
+            for (int i = 0; i < count; i += 3) {
+                int digits = (count - i < 3) ? count - i : 3;
+                int v      = reader.read(digits * 3 + 1);
+                if (v < 0) {
+                    return -1;
+                }
+                for (int d = digits - 1; 0 <= d; d--) {
+                    out[len + d] = (char)('0' + v % 10);
+                    v /= 10;
+                }
+                len += digits;
+            }
+        }
+    }
+    out[len] = '\0';
+    return (int)len;
+}
+
+int qr_decode(const QRCodeGenerator::Matrix& qrcode, char* out, size_t out_size)
+{
+    int size    = qrcode.size;
+    int version = (size - 17) / 4;
+    if (version < 1 || QRCodeGenerator::MAX_VERSION < version || size != version * 4 + 17 || 0 == out_size) {
+        return -1;
+    }
+
+    int ecl  = 0;
+    int mask = 0;
+    if (!read_format(qrcode, &ecl, &mask)) {
+        return -1;
+    }
+
+    static bool function[QRCodeGenerator::MAX_SIZE * QRCodeGenerator::MAX_SIZE];
+    mark_function_patterns(function, version, size);
+
+    // 総コード語数
+    int raw_modules = (16 * version + 128) * version + 64;
+    if (2 <= version) {
+        int count = version / 7 + 2;
+        raw_modules -= (25 * count - 10) * count - 55;
+        if (7 <= version) {
+            raw_modules -= 36;
+        }
+    }
+    int total = raw_modules / 8;
+
+    // ジグザグ読み取り（右下から2列ずつ、上下交互）
+    uint8_t raw[MAX_CODEWORDS];
+    memset(raw, 0, sizeof(raw));
+    int bit = 0;
+    for (int right = size - 1; 1 <= right; right -= 2) {
+        if (6 == right) {
+            right = 5;
+        }
+        for (int vert = 0; vert < size; vert++) {
+            for (int j = 0; j < 2; j++) {
+                int x       = right - j;
+                bool upward = 0 == ((right + 1) & 2);
+                int y       = upward ? size - 1 - vert : vert;
+                if (!function[y * size + x] && bit < total * 8) {
+                    if (qrcode.get(x, y) != mask_bit(mask, x, y)) {
+                        raw[bit >> 3] |= (uint8_t)(0x80 >> (bit & 7));
+                    }
+                    bit++;
+                }
+            }
+        }
+    }
+
+    // ブロックへの振り分け（短いブロックが先、長いブロックはデータが1語多い）
+    int blocks      = NUM_BLOCKS[ecl][version];
+    int ecc_len     = ECC_PER_BLOCK[ecl][version];
+    int short_len   = total / blocks;
+    int short_count = blocks - total % blocks;
+    int short_data  = short_len - ecc_len;
+
+    uint8_t block_buf[MAX_CODEWORDS];
+    int block_start[8];
+    for (int b = 0, start = 0; b < blocks; b++) {
+        block_start[b] = start;
+        start += short_len + (b < short_count ? 0 : 1);
+    }
+
+    int index = 0;
+    for (int i = 0; i <= short_len; i++) {
+        for (int b = 0; b < blocks; b++) {
+            bool is_short = b < short_count;
+            if (i == short_data && is_short) {
+                continue;  // 短いブロックにはこの位置のデータ語がない
+            }
+            int pos                         = (is_short && short_data < i) ? i - 1 : i;
+            block_buf[block_start[b] + pos] = raw[index++];
+        }
+    }
+    if (index != total) {
+        return -1;
+    }
+
+    // 各ブロックのシンドローム検査（α^0〜α^(ecc_len-1) を根とする生成多項式）
+    uint8_t data[MAX_CODEWORDS];
+    int data_len = 0;
+    for (int b = 0; b < blocks; b++) {
+        int len              = short_len + (b < short_count ? 0 : 1);
+        const uint8_t* block = block_buf + block_start[b];
+        uint8_t root         = 1;
+        for (int k = 0; k < ecc_len; k++) {
+            uint8_t s = 0;
+            for (int i = 0; i < len; i++) {
+                s = gf_mul(s, root) ^ block[i];
+            }
+            if (0 != s) {
+                return -1;
+            }
+            root = gf_mul(root, 2);
+        }
+        memcpy(data + data_len, block, len - ecc_len);
+        data_len += len - ecc_len;
+    }
+
+    BitReader reader = {data, data_len * 8, 0};
+    return decode_segments(reader, version, out, out_size);
+}
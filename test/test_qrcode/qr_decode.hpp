@@ -0,0 +1,20 @@
+#ifndef __QR_DECODE_HPP__
+#define __QR_DECODE_HPP__
+
+#include <stddef.h>
+
+#include "qrcode_generator.hpp"
+
+/**
+ * @brief 検証用の最小QRデコーダー（バージョン1〜10）
+ * 歪み・欠損のないモジュール行列のみを対象とし、誤り訂正は行わない。
+ * 形式情報（誤り訂正レベル・マスク）の読み取り、マスク解除、ブロックの並べ替え、
+ * 全ブロックのReed-Solomonシンドローム検査、数字/英数字/バイトモードの復号を行う。
+ * @param qrcode 復号するモジュール行列
+ * @param out 復号したテキストの出力先（終端付き）
+ * @param out_size 出力先のサイズ
+ * @return テキストのバイト数、失敗した場合は -1
+ */
+int qr_decode(const QRCodeGenerator::Matrix& qrcode, char* out, size_t out_size);
+
+#endif  // __QR_DECODE_HPP__
@@ -0,0 +1,76 @@
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+
+#include "qr_decode.hpp"
+#include "qrcode_generator.hpp"
+
+// QRコードの往復検証（生成→内蔵の簡易デコーダーで復号して元のテキストと一致するか）
+
+static QRCodeGenerator::Matrix qr;
+
+void setUp(void)
+{
+    memset(&qr, 0, sizeof(qr));
+}
+
+void tearDown(void)
+{
+}
+
+static void check_roundtrip(const char* text, uint8_t expected_version)
+{
+    char decoded[300];
+    TEST_ASSERT_TRUE_MESSAGE(QRCodeGenerator::generate(text, qr), text);
+    if (0 != expected_version) {
+        TEST_ASSERT_EQUAL_UINT8_MESSAGE(expected_version, qr.version, text);
+    }
+    TEST_ASSERT_TRUE_MESSAGE(0 <= qr_decode(qr, decoded, sizeof(decoded)), text);
+    TEST_ASSERT_EQUAL_STRING(text, decoded);
+}
+
+///////////////////////////////////////
+/// @brief アプリが表示するテキストと各モード（バイト・英数字・数字）
+static void test_roundtrip_fixed_texts(void)
+{
+    check_roundtrip("http://192.168.4.1/", 0);
+    check_roundtrip("WIFI:T:WPA;S:M5Stack-Scale-Setup-0123;P:correct-horse-battery-staple;;", 0);
+    check_roundtrip("HTTP://192.168.4.1/SETUP", 0);  // 英数字モード
+    check_roundtrip("20251018123456", 0);            // 数字モード
+}
+
+///////////////////////////////////////
+/// @brief 各バージョンの容量ちょうどのバイトモードデータ
+static void test_roundtrip_each_version_capacity(void)
+{
+    static const uint16_t capacity[QRCodeGenerator::MAX_VERSION] = {17, 32, 53, 78, 106, 134, 154, 192, 230, 271};
+
+    char text[300];
+    for (int v = 0; v < QRCodeGenerator::MAX_VERSION; v++) {
+        for (int i = 0; i < capacity[v]; i++) {
+            text[i] = (char)('a' + (i * 7 + v) % 26);
+        }
+        text[capacity[v]] = '\0';
+        check_roundtrip(text, (uint8_t)(v + 1));
+    }
+}
+
+///////////////////////////////////////
+/// @brief モジュールが1つ反転していれば復号できない（デコーダー自体の検査）
+static void test_corrupted_module_rejected(void)
+{
+    char decoded[300];
+    TEST_ASSERT_TRUE(QRCodeGenerator::generate("http://192.168.4.1/", qr));
+    int last = qr.size - 1;
+    qr.set(last, last, !qr.get(last, last));
+    TEST_ASSERT_TRUE(qr_decode(qr, decoded, sizeof(decoded)) < 0);
+}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_roundtrip_fixed_texts);
+    RUN_TEST(test_roundtrip_each_version_capacity);
+    RUN_TEST(test_corrupted_module_rejected);
+    return UNITY_END();
+}
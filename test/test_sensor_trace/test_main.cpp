@@ -0,0 +1,149 @@
+#include <string.h>
+#include <unity.h>
+
+#include "sensor_trace.hpp"
+
+// センサートレースの行形式の検証（記録した行をエミュレーターが読めるか）
+
+static SensorTraceSample sample;
+static SensorTraceCalibration calib;
+static ButtonEvent edge;
+
+void setUp(void)
+{
+    memset(&sample, 0, sizeof(sample));
+    memset(&calib, 0, sizeof(calib));
+    memset(&edge, 0, sizeof(edge));
+}
+
+void tearDown(void)
+{
+}
+
+///////////////////////////////////////
+/// @brief 書き出したサンプル行を読み戻せる
+static void test_sample_round_trip(void)
+{
+    SensorTraceSample in = {123456, -8000123, {0.01f, -0.02f, 0.98f}, {1.5f, -2.25f, 0.0f}, SENSOR_TRACE_BUTTON_B};
+    char line[SENSOR_TRACE_LINE_MAX];
+    int length = sensor_trace_format_sample(line, sizeof(line), in);
+    TEST_ASSERT_TRUE(0 < length && length < (int)sizeof(line));
+
+    TEST_ASSERT_EQUAL_CHAR('S', sensor_trace_parse_line(line, &sample, &calib));
+    TEST_ASSERT_EQUAL_UINT32(in.time_ms, sample.time_ms);
+    TEST_ASSERT_EQUAL_INT32(in.raw, sample.raw);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(0.0001f, in.accel[i], sample.accel[i]);
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, in.gyro[i], sample.gyro[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT8(SENSOR_TRACE_BUTTON_B, sample.buttons);
+}
+
+///////////////////////////////////////
+/// @brief 書き出した校正行を読み戻せる
+static void test_calibration_round_trip(void)
+{
+    SensorTraceCalibration in = {8123, 27.61234f};
+    char line[SENSOR_TRACE_LINE_MAX];
+    sensor_trace_format_calibration(line, sizeof(line), in);
+
+    TEST_ASSERT_EQUAL_CHAR('H', sensor_trace_parse_line(line, &sample, &calib));
+    TEST_ASSERT_EQUAL_INT32(8123, calib.offset);
+    TEST_ASSERT_FLOAT_WITHIN(0.00001f, 27.61234f, calib.scale);
+}
+
+///////////////////////////////////////
+/// @brief 書き出したボタンのエッジ行を読み戻せる
+static void test_button_round_trip(void)
+{
+    ButtonEvent in = {4294967000u, ButtonEvent::B, true};
+    char line[SENSOR_TRACE_LINE_MAX];
+    sensor_trace_format_button(line, sizeof(line), in);
+
+    TEST_ASSERT_EQUAL_CHAR('B', sensor_trace_parse_line(line, &sample, &calib, &edge));
+    TEST_ASSERT_EQUAL_UINT32(in.time_ms, edge.time_ms);
+    TEST_ASSERT_EQUAL_UINT8(ButtonEvent::B, edge.button);
+    TEST_ASSERT_TRUE(edge.pressed);
+
+    TEST_ASSERT_EQUAL_CHAR('B', sensor_trace_parse_line("B,20,0,0\n", &sample, &calib, &edge));
+    TEST_ASSERT_EQUAL_UINT32(20, edge.time_ms);
+    TEST_ASSERT_EQUAL_UINT8(ButtonEvent::A, edge.button);
+    TEST_ASSERT_FALSE(edge.pressed);
+}
+
+///////////////////////////////////////
+/// @brief ボタン列は省略できる（古いトレース）
+static void test_buttons_column_optional(void)
+{
+    TEST_ASSERT_EQUAL_CHAR('S', sensor_trace_parse_line("S,10,20,0,0,1,0,0,0\n", &sample, &calib));
+    TEST_ASSERT_EQUAL_UINT32(10, sample.time_ms);
+    TEST_ASSERT_EQUAL_INT32(20, sample.raw);
+    TEST_ASSERT_EQUAL_UINT8(0, sample.buttons);
+}
+
+///////////////////////////////////////
+/// @brief シリアルログに混在する他の行・欠けた行は無視し、出力先を書き換えない
+static void test_other_lines_ignored(void)
+{
+    static const char* const lines[] = {
+        "I (1234) WiFi connected! IP: 192.168.1.10\n",
+        "S",
+        "S,",
+        "S,12",
+        "S,12,34,0.1,0.2",
+        "S,x,34,0,0,0,0,0,0,0",
+        "H,",
+        "H,100",
+        "H,100,abc",
+        "B,",
+        "B,10",
+        "B,10,1",
+        "B,10,1,",
+        "B,x,1,1",
+        "Screen: main -> trend",
+    };
+    sample.raw   = 42;
+    calib.offset = 42;
+    edge.time_ms = 42;
+    for (const char* line : lines) {
+        TEST_ASSERT_EQUAL_CHAR(0, sensor_trace_parse_line(line, &sample, &calib, &edge));
+    }
+    TEST_ASSERT_EQUAL_CHAR(0, sensor_trace_parse_line(nullptr, &sample, &calib, &edge));
+    TEST_ASSERT_EQUAL_INT32(42, sample.raw);
+    TEST_ASSERT_EQUAL_INT32(42, calib.offset);
+    TEST_ASSERT_EQUAL_UINT32(42, edge.time_ms);
+}
+
+///////////////////////////////////////
+/// @brief 受け取り先がない種類の行は該当なし
+static void test_missing_destination(void)
+{
+    TEST_ASSERT_EQUAL_CHAR(0, sensor_trace_parse_line("H,100,2.5", &sample, nullptr));
+    TEST_ASSERT_EQUAL_CHAR(0, sensor_trace_parse_line("S,10,20,0,0,1,0,0,0,0", nullptr, &calib));
+    TEST_ASSERT_EQUAL_CHAR(0, sensor_trace_parse_line("B,10,0,1", &sample, &calib));
+}
+
+///////////////////////////////////////
+/// @brief 生カウントのグラム換算
+static void test_to_grams(void)
+{
+    SensorTraceCalibration c = {8000, 25.0f};
+    TEST_ASSERT_EQUAL_FLOAT(100.0f, sensor_trace_to_grams(c, 10500));
+    TEST_ASSERT_EQUAL_FLOAT(-40.0f, sensor_trace_to_grams(c, 7000));
+
+    c.scale = 0.0f;  // 未校正
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, sensor_trace_to_grams(c, 10500));
+}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_sample_round_trip);
+    RUN_TEST(test_calibration_round_trip);
+    RUN_TEST(test_button_round_trip);
+    RUN_TEST(test_buttons_column_optional);
+    RUN_TEST(test_other_lines_ignored);
+    RUN_TEST(test_missing_destination);
+    RUN_TEST(test_to_grams);
+    return UNITY_END();
+}
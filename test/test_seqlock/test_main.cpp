@@ -0,0 +1,105 @@
+#include <unity.h>
+
+#include <atomic>
+#include <thread>
+
+#include "sensor_snapshot.hpp"
+#include "seqlock.hpp"
+
+// シーケンスロックの一貫性の検証
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+///////////////////////////////////////
+/// @brief 公開前は 0、公開後は最新の値と通し番号を返す
+static void test_read_latest(void)
+{
+    Seqlock<SensorSnapshot> lock;
+    SensorSnapshot s = {};
+    TEST_ASSERT_EQUAL_UINT32(0, lock.read(&s));
+
+    s.weight_serial = 1;
+    s.weight_grams  = 12.5f;
+    lock.publish(s);
+    s.weight_serial = 2;
+    s.weight_grams  = 25.0f;
+    lock.publish(s);
+
+    SensorSnapshot out;
+    TEST_ASSERT_EQUAL_UINT32(2, lock.read(&out));
+    TEST_ASSERT_EQUAL_UINT32(2, out.weight_serial);
+    TEST_ASSERT_EQUAL_FLOAT(25.0f, out.weight_grams);
+}
+
+///////////////////////////////////////
+/// @brief 書き込み1・読み出し3スレッド
+/// 書き込みスレッドが全要素に同じ値を入れて公開し続け、読み出しスレッドが要素の食い違いを探す
+static void test_concurrent_readers_never_see_torn_snapshot(void)
+{
+    static const uint32_t PUBLISHES = 200000;
+    static const int READERS        = 3;
+
+    Seqlock<SensorSnapshot> lock;
+    std::atomic<bool> done(false);
+    std::atomic<uint32_t> torn(0);
+    std::atomic<uint32_t> backwards(0);
+
+    auto reader = [&]() {
+        uint32_t last = 0;
+        while (!done.load(std::memory_order_relaxed)) {
+            SensorSnapshot s;
+            uint32_t serial = lock.read(&s);
+            if (0 == serial) {
+                continue;
+            }
+            uint32_t v = s.weight_serial;
+            if (s.time_ms != v || s.weight_grams != (float)v || s.accel[2] != (float)v || s.gyro[0] != (float)v ||
+                s.battery_voltage != (float)v) {
+                torn++;
+            }
+            if (serial < last) {
+                backwards++;
+            }
+            last = serial;
+        }
+    };
+
+    std::thread threads[READERS];
+    for (int i = 0; i < READERS; i++) {
+        threads[i] = std::thread(reader);
+    }
+    for (uint32_t v = 1; v <= PUBLISHES; v++) {
+        SensorSnapshot s  = {};
+        s.time_ms         = v;
+        s.weight_serial   = v;
+        s.weight_grams    = (float)v;
+        s.accel[2]        = (float)v;
+        s.gyro[0]         = (float)v;
+        s.battery_voltage = (float)v;
+        lock.publish(s);
+    }
+    done = true;
+    for (int i = 0; i < READERS; i++) {
+        threads[i].join();
+    }
+
+    SensorSnapshot last;
+    TEST_ASSERT_EQUAL_UINT32(0, torn.load());
+    TEST_ASSERT_EQUAL_UINT32(0, backwards.load());
+    TEST_ASSERT_EQUAL_UINT32(PUBLISHES, lock.read(&last));
+    TEST_ASSERT_EQUAL_UINT32(PUBLISHES, last.weight_serial);
+}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_read_latest);
+    RUN_TEST(test_concurrent_readers_never_see_torn_snapshot);
+    return UNITY_END();
+}
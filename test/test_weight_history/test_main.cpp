@@ -0,0 +1,191 @@
+#include <unity.h>
+
+#include "weight_history.hpp"
+
+// 重量履歴（多段ダウンサンプリング）の検証
+
+static WeightHistory history;
+
+void setUp(void)
+{
+    history.clear();
+}
+
+void tearDown(void)
+{
+}
+
+///////////////////////////////////////
+/// @brief 1秒ごとにバケットを確定し、min/max/mean/count を集計する
+static void test_one_second_buckets(void)
+{
+    // 0〜2.9秒に100msごと（1秒目は 0..9 g、2秒目は 10..19 g、3秒目は 20..29 g）
+    for (uint32_t i = 0; i < 30; i++) {
+        history.add((float)i, i * 100);
+    }
+    TEST_ASSERT_EQUAL_UINT16(2, history.count(WeightHistory::TIER_1S));
+    TEST_ASSERT_EQUAL_UINT32(2, history.closedSerial(WeightHistory::TIER_1S));
+
+    const WeightBucket& latest = history.bucket(WeightHistory::TIER_1S, 0);
+    TEST_ASSERT_EQUAL_UINT32(10, latest.count);
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, latest.min);
+    TEST_ASSERT_EQUAL_FLOAT(19.0f, latest.max);
+    TEST_ASSERT_EQUAL_FLOAT(14.5f, latest.mean);
+
+    const WeightBucket& oldest = history.bucket(WeightHistory::TIER_1S, 1);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, oldest.min);
+    TEST_ASSERT_EQUAL_FLOAT(9.0f, oldest.max);
+}
+
+///////////////////////////////////////
+/// @brief サンプルのない区間は count=0 の欠測バケットになる
+static void test_missing_seconds_are_empty_buckets(void)
+{
+    history.add(1.0f, 0);
+    history.add(2.0f, 5500);
+
+    TEST_ASSERT_EQUAL_UINT16(5, history.count(WeightHistory::TIER_1S));
+    for (uint16_t age = 0; age < 4; age++) {
+        TEST_ASSERT_EQUAL_UINT32(0, history.bucket(WeightHistory::TIER_1S, age).count);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, history.bucket(WeightHistory::TIER_1S, 4).count);
+
+    // 5.5秒のサンプルは 5〜6秒のバケットに入る
+    history.add(3.0f, 6000);
+    TEST_ASSERT_EQUAL_UINT32(1, history.bucket(WeightHistory::TIER_1S, 0).count);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, history.bucket(WeightHistory::TIER_1S, 0).mean);
+}
+
+///////////////////////////////////////
+/// @brief 1秒バケットが閉じるたびに1分の段へ集約する
+static void test_cascade_to_minutes(void)
+{
+    // 0〜61秒に100msごと、値は1分目が 1 g、2分目が 3 g
+    for (uint32_t t = 0; t <= 61000; t += 100) {
+        history.add((t < 60000) ? 1.0f : 3.0f, t);
+    }
+    TEST_ASSERT_EQUAL_UINT16(1, history.count(WeightHistory::TIER_1MIN));
+    const WeightBucket& minute = history.bucket(WeightHistory::TIER_1MIN, 0);
+    TEST_ASSERT_EQUAL_UINT32(600, minute.count);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, minute.mean);
+    TEST_ASSERT_EQUAL_UINT16(0, history.count(WeightHistory::TIER_15MIN));
+}
+
+///////////////////////////////////////
+/// @brief リングが一周したら古いバケットから上書きする
+static void test_ring_wraps(void)
+{
+    for (uint32_t s = 0; s <= WeightHistory::CAPACITY_1S + 10; s++) {
+        history.add((float)s, s * 1000);
+    }
+    TEST_ASSERT_EQUAL_UINT16(WeightHistory::CAPACITY_1S, history.count(WeightHistory::TIER_1S));
+    TEST_ASSERT_EQUAL_UINT32(WeightHistory::CAPACITY_1S + 10, history.closedSerial(WeightHistory::TIER_1S));
+    TEST_ASSERT_EQUAL_FLOAT((float)(WeightHistory::CAPACITY_1S + 9), history.bucket(WeightHistory::TIER_1S, 0).mean);
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, history.bucket(WeightHistory::TIER_1S, WeightHistory::CAPACITY_1S - 1).mean);
+}
+
+///////////////////////////////////////
+/// @brief 直近 n 個のバケットの集約（欠測バケットは平均に含めない）
+static void test_summarize(void)
+{
+    history.add(4.0f, 0);
+    history.add(8.0f, 1000);
+    history.add(6.0f, 3000);  // 2〜3秒は欠測
+    history.add(0.0f, 4000);
+
+    WeightBucket out;
+    TEST_ASSERT_EQUAL_UINT16(4, history.summarize(WeightHistory::TIER_1S, 10, &out));
+    TEST_ASSERT_EQUAL_UINT32(3, out.count);
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, out.min);
+    TEST_ASSERT_EQUAL_FLOAT(8.0f, out.max);
+    TEST_ASSERT_EQUAL_FLOAT(6.0f, out.mean);
+
+    TEST_ASSERT_EQUAL_UINT16(2, history.summarize(WeightHistory::TIER_1S, 2, &out));
+    TEST_ASSERT_EQUAL_UINT32(1, out.count);
+    TEST_ASSERT_EQUAL_FLOAT(6.0f, out.mean);
+}
+
+///////////////////////////////////////
+/// @brief リング1周より長い空白：古いサンプルはリングに残さず、直近1周分は欠測、区間の境界はずらさない
+static void test_gap_longer_than_ring(void)
+{
+    const uint32_t gap_ms = 10UL * 60UL * 1000UL;  // 10分（1秒の段は1分で1周）
+    history.add(1.0f, 0);
+    history.add(2.0f, gap_ms + 250);
+
+    // 0秒のバケット＋直近60秒分の欠測バケットを確定
+    TEST_ASSERT_EQUAL_UINT16(WeightHistory::CAPACITY_1S, history.count(WeightHistory::TIER_1S));
+    TEST_ASSERT_EQUAL_UINT32(WeightHistory::CAPACITY_1S + 1, history.closedSerial(WeightHistory::TIER_1S));
+    for (uint16_t age = 0; age < WeightHistory::CAPACITY_1S; age++) {
+        TEST_ASSERT_EQUAL_UINT32(0, history.bucket(WeightHistory::TIER_1S, age).count);
+    }
+
+    // 空白後のサンプルは秒の境界で始まるバケットに入る（次の秒の境界で確定する）
+    history.add(3.0f, gap_ms + 999);
+    TEST_ASSERT_EQUAL_UINT32(WeightHistory::CAPACITY_1S + 1, history.closedSerial(WeightHistory::TIER_1S));
+    history.add(4.0f, gap_ms + 1000);
+    TEST_ASSERT_EQUAL_UINT32(WeightHistory::CAPACITY_1S + 2, history.closedSerial(WeightHistory::TIER_1S));
+    const WeightBucket& after = history.bucket(WeightHistory::TIER_1S, 0);
+    TEST_ASSERT_EQUAL_UINT32(2, after.count);
+    TEST_ASSERT_EQUAL_FLOAT(2.5f, after.mean);
+
+    // 1分の段：最初の1分にサンプル1件、残りの9分は欠測
+    TEST_ASSERT_EQUAL_UINT16(10, history.count(WeightHistory::TIER_1MIN));
+    TEST_ASSERT_EQUAL_UINT32(1, history.bucket(WeightHistory::TIER_1MIN, 9).count);
+    for (uint16_t age = 0; age < 9; age++) {
+        TEST_ASSERT_EQUAL_UINT32(0, history.bucket(WeightHistory::TIER_1MIN, age).count);
+    }
+}
+
+///////////////////////////////////////
+/// @brief 数時間の空白：どの段でも古いサンプルは現在時刻どおりの古さに置き、リングから外れたものは残さない
+static void test_gap_of_hours(void)
+{
+    const uint32_t gap_ms = 3UL * 3600UL * 1000UL;  // 3時間（1分の段は1時間で1周）
+    for (uint32_t t = 0; t < 60000; t += 1000) {
+        history.add(5.0f, t);
+    }
+    history.add(6.0f, gap_ms);
+
+    for (uint16_t age = 0; age < history.count(WeightHistory::TIER_1S); age++) {
+        TEST_ASSERT_EQUAL_UINT32(0, history.bucket(WeightHistory::TIER_1S, age).count);
+    }
+    for (uint16_t age = 0; age < history.count(WeightHistory::TIER_1MIN); age++) {
+        TEST_ASSERT_EQUAL_UINT32(0, history.bucket(WeightHistory::TIER_1MIN, age).count);
+    }
+
+    // 15分の段：確定済みは 0〜165分の11個（165〜180分は集計中）、0〜15分のバケットは最も古い
+    TEST_ASSERT_EQUAL_UINT16(11, history.count(WeightHistory::TIER_15MIN));
+    TEST_ASSERT_EQUAL_UINT32(60, history.bucket(WeightHistory::TIER_15MIN, 10).count);
+    for (uint16_t age = 0; age < 10; age++) {
+        TEST_ASSERT_EQUAL_UINT32(0, history.bucket(WeightHistory::TIER_15MIN, age).count);
+    }
+}
+
+///////////////////////////////////////
+/// @brief リングちょうど1周の空白では打ち切らない
+static void test_gap_of_exactly_one_ring(void)
+{
+    history.add(1.0f, 0);
+    history.add(2.0f, WeightHistory::CAPACITY_1S * 1000UL + 500);
+
+    TEST_ASSERT_EQUAL_UINT32(WeightHistory::CAPACITY_1S, history.closedSerial(WeightHistory::TIER_1S));
+    TEST_ASSERT_EQUAL_UINT32(1, history.bucket(WeightHistory::TIER_1S, WeightHistory::CAPACITY_1S - 1).count);
+    history.add(3.0f, WeightHistory::CAPACITY_1S * 1000UL + 1000);
+    TEST_ASSERT_EQUAL_UINT32(WeightHistory::CAPACITY_1S + 1, history.closedSerial(WeightHistory::TIER_1S));
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, history.bucket(WeightHistory::TIER_1S, 0).mean);
+}
+
+int main(int argc, char** argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_one_second_buckets);
+    RUN_TEST(test_missing_seconds_are_empty_buckets);
+    RUN_TEST(test_cascade_to_minutes);
+    RUN_TEST(test_ring_wraps);
+    RUN_TEST(test_summarize);
+    RUN_TEST(test_gap_longer_than_ring);
+    RUN_TEST(test_gap_of_exactly_one_ring);
+    RUN_TEST(test_gap_of_hours);
+    return UNITY_END();
+}